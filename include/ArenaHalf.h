@@ -0,0 +1,54 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Player.h"
+#include "Enemy.h"
+#include "Bullet.h"
+#include "SpatialGrid.h"
+#include "FlowField.h"
+#include "JobSystem.h"
+
+// Eine Spielfeldhälfte mit ihren Gegnern, Kugeln, dem Kollisionsgitter und
+// dem Flussfeld zum Spieler dieser Hälfte.
+// Gegner verlassen ihre Hälfte nie und Kugeln enden an der Mittellinie,
+// deshalb müssen nur Objekte derselben Hälfte gegeneinander geprüft werden.
+class ArenaHalf {
+private:
+    bool leftSide;
+
+    // Kollision
+    SpatialGrid enemyGrid;
+    std::vector<std::uint8_t> enemyHit; // Im aktuellen Schritt getroffen, wird danach entfernt
+    std::vector<std::uint64_t> contacts; // Bitmaske der Gegner, die den Spieler berühren
+    std::vector<std::uint32_t> bulletHit; // Zuerst getroffener Gegner je Kugel, NO_HIT für keinen
+    std::vector<std::uint8_t> bulletRemove; // Kugel wird am Ende des Schritts entfernt
+
+    // Navigation
+    FlowField flowField;
+    std::vector<float> pushX, pushY; // Verschiebung aus der Separation im aktuellen Schritt
+
+    std::uint32_t findHit(std::size_t bullet, float dt, float reach) const;
+
+public:
+    EnemyStore enemies;
+    BulletStore bullets;
+
+    explicit ArenaHalf(bool leftSide);
+
+    void reserveEnemies(std::size_t capacity);
+    void addObstacle(float left, float top, float width, float height);
+    int update(float dt, const Player& player, JobSystem& jobs);
+    void separateEnemies(float dt, JobSystem& jobs);
+    void clear();
+
+    // Spielstand: Gegner und Kugeln; Gitter, Flussfeld und Puffer werden
+    // jeden Schritt neu aufgebaut
+    void saveState(SimulationState& state) const;
+    bool loadState(StateReader& in);
+
+    // Getter
+    bool isLeftSide() const { return leftSide; }
+    std::size_t getWorkload() const { return enemies.size() + bullets.size(); }
+    float getLeft() const;
+    float getRight() const;
+};
\ No newline at end of file
@@ -0,0 +1,6 @@
+#pragma once
+#include <string>
+#include "Headless.h"
+
+// Headless-Benchmarks, Aufruf über --bench <name>
+int runBenchmark(const std::string& name, const HeadlessOptions& options);
\ No newline at end of file
@@ -1,20 +1,45 @@
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 #include "Enemy.h"
 
-class Bullet {
+class SimulationState;
+class StateReader;
+
+// Kugeln einer Spielfeldhälfte als Structure of Arrays und fester Pool,
+// analog zu EnemyStore. Eine Kugel gehört zu der Hälfte, in der sie
+// abgefeuert wurde.
+class BulletStore {
 private:
-    sf::CircleShape shape;
-    sf::Vector2f position;
-    sf::Vector2f velocity;
-    bool startedLeft;
+    bool leftSide;
+    std::size_t capacity;
+    std::size_t dropped; // Wegen vollem Pool verworfene Schüsse
 
 public:
-    Bullet(float x, float y, const sf::Vector2f& dir);
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<std::uint8_t> status;  // Simd::BULLET_* aus dem letzten update()
+
+    BulletStore(bool leftSide, std::size_t capacity);
+
+    bool add(float posX, float posY, const sf::Vector2f& dir);
+    void remove(std::size_t i);
+    void clear();
+
+    void update(float dt, std::size_t begin, std::size_t end);
+    bool isOutOfBounds(std::size_t i) const;
+    float getStopX() const;
+    float middleFraction(std::size_t i, float dt) const;
+    float sweepHit(std::size_t i, float dt, const EnemyStore& enemies, std::size_t enemy) const;
+
+    // Spielstand
+    void saveState(SimulationState& state) const;
+    bool loadState(StateReader& in);
 
-    void update(float dt);
-    void draw(sf::RenderWindow& window);
-    bool isOutOfBounds() const;
-    bool shouldStopAtMiddle() const;
-    bool checkHit(Enemy& enemy);
+    std::size_t size() const { return x.size(); }
+    std::size_t getCapacity() const { return capacity; }
+    std::size_t getDropped() const { return dropped; }
+    sf::Vector2f getPosition(std::size_t i) const { return sf::Vector2f(x[i], y[i]); }
 };
\ No newline at end of file
@@ -13,11 +13,63 @@ namespace Constants {
     const int PLAYER_MAX_HEALTH = 3;
     const float ENEMY_SPAWN_INTERVAL = 2.0f;
 
-    // Gren
+    // Größen
     const float PLAYER_RADIUS = 20.0f;
     const float ENEMY_RADIUS = 15.0f;
     const float BULLET_RADIUS = 5.0f;
 
+    // Simulation
+    const float SIM_TICK_RATE = 120.0f;   // Feste Simulationsschritte pro Sekunde
+    const int MAX_CATCHUP_STEPS = 5;      // Max. Nachhol-Schritte pro Frame
+    const int MAX_BEHIND_PASSES = 3;      // Max. Durchläufe in Folge mit Rückstand
+    const float MAX_FRAME_TIME = 0.25f;   // Längere Hänger werden abgeschnitten
+    const float MAX_SIM_TICK_RATE = 1000000.0f; // Schritte mindestens 1 µs auseinander
+    const float WEAPON_DRAG = 0.98f;      // Geschwindigkeitsfaktor je 1/60 s
+
+    // Kollision
+    const float GRID_CELL_SIZE = 32.0f;   // Zellgröße des Gegner-Gitters
+
+    // Navigation
+    const float FLOW_CELL_SIZE = 20.0f;   // Zellgröße des Flussfelds
+    const float SEPARATION_STRENGTH = 0.5f; // Anteil der Überlappung, der je Schritt aufgelöst wird
+    const float SEPARATION_MAX_PUSH = 2.0f; // Max. Verschiebung eines Gegners je Schritt
+    const unsigned int SEPARATION_MAX_NEIGHBOURS = 32; // Darüber gilt die Umgebung als überfüllt
+
+    // Threads: Blockgrößen für parallelFor. Gegnerblöcke sind Vielfache von 64,
+    // damit jeder Block eigene Wörter der Kontakt-Bitmaske schreibt.
+    const unsigned int PARALLEL_ENEMY_GRAIN = 2048;
+    const unsigned int PARALLEL_BULLET_GRAIN = 256;
+    const unsigned int PARALLEL_HALVES_MIN_WORK = 256; // Gegner + Kugeln je Hälfte, ab denen die Hälften parallel laufen
+
+    // Pools, je Spielfeldhälfte. Volle Pools verwerfen neue Gegner bzw. Schüsse.
+    const unsigned int ENEMY_POOL_SIZE = 4096;
+    const unsigned int BULLET_POOL_SIZE = 1024;
+    const unsigned int ENEMY_MAX_CAPACITY = 1u << 21;  // Obergrenze jeder Hälfte, auch für geladene Spielstände
+    const unsigned int FRAME_ARENA_SIZE = 64 * 1024; // Bytes für kurzlebige Daten je Frame
+
     // Controller
     const float JOYSTICK_DEADZONE = 15.0f;
+    const float TRIGGER_THRESHOLD = 50.0f;   // Achsenwert, ab dem RT/LT als gedrückt gelten
+
+    // Eingabe
+    const unsigned int INPUT_QUEUE_SIZE = 1024; // Ereignisse zwischen Event-Pump und Simulation, Zweierpotenz
+    const float INPUT_SAMPLE_RATE = 1000.0f;    // Abfragen der Eingabegeräte pro Sekunde
+
+    // Aufnahmen
+    const unsigned int REPLAY_KEYFRAME_INTERVAL = 1200; // Schritte zwischen zwei Keyframes, bei 120 Hz alle 10 s
+    const float REPLAY_SEEK_SECONDS = 5.0f;             // Sprungweite beim Spulen in der Wiedergabe
+    const float MIN_REPLAY_SPEED = 0.01f;
+    const float MAX_REPLAY_SPEED = 1000.0f;
+
+    // Online-Koop
+    const unsigned short NET_DEFAULT_PORT = 47800;
+    const unsigned int NET_ROLLBACK_WINDOW = 8;      // Schritte, die ein Peer dem anderen vorauslaufen darf
+    const unsigned int NET_MAX_ROLLBACK_WINDOW = 60;
+    const unsigned int NET_MAX_INPUTS_PER_PACKET = 64; // Hält Pakete unter der üblichen MTU
+    const float NET_CONNECT_TIMEOUT = 30.0f;         // Sekunden Warten auf den Mitspieler
+    const float NET_TIMEOUT = 5.0f;                  // Sekunden ohne Paket, bis der Mitspieler als getrennt gilt
+    const float NET_HELLO_INTERVAL = 0.25f;          // Sekunden zwischen Verbindungsanfragen
+
+    // Latenzmessung
+    const unsigned int LATENCY_SAMPLE_COUNT = 1 << 16; // Messwerte je Messpunkt, danach werden die ältesten überschrieben
 }
\ No newline at end of file
@@ -1,19 +1,45 @@
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 #include "Player.h"
+#include "FlowField.h"
 
-class Enemy {
+class SimulationState;
+class StateReader;
+
+// Gegner einer Spielfeldhälfte als Structure of Arrays. Enthält nur
+// Simulationsdaten, die Geometrie zum Zeichnen erzeugt Game erst beim Rendern.
+// Alle Gegner einer Hälfte jagen denselben Spieler.
+// Fester Pool: der Speicher wird einmal reserviert, lebende Gegner liegen
+// dicht am Anfang und entfernte Plätze werden per Swap-and-Pop wiederverwendet.
+class EnemyStore {
 private:
-    sf::CircleShape shape;
-    sf::Vector2f position;
-    Player* target;
+    std::size_t capacity;
+    std::size_t dropped; // Wegen vollem Pool verworfene Gegner
 
 public:
-    Enemy(float x, float y, Player* t);
+    std::vector<float> x, y;           // Position
+    std::vector<float> vx, vy;         // Geschwindigkeit im letzten Schritt
+
+    explicit EnemyStore(std::size_t capacity);
+
+    void reserve(std::size_t newCapacity);
+    bool add(float posX, float posY);
+    void remove(std::size_t i);
+    void clear();
+
+    // Bereich [begin, end), damit Blöcke parallel laufen können
+    void update(float dt, const Player& target, const FlowField& field, std::size_t begin, std::size_t end);
+    void checkCollisions(const Player& player, std::vector<std::uint64_t>& hits, std::size_t begin, std::size_t end) const;
 
-    void update(float dt);
-    void draw(sf::RenderWindow& window);
-    bool checkCollision(Player& player);
+    // Spielstand
+    void saveState(SimulationState& state) const;
+    bool loadState(StateReader& in);
 
-    sf::Vector2f getPosition() const { return position; }
+    std::size_t size() const { return x.size(); }
+    std::size_t getCapacity() const { return capacity; }
+    std::size_t getDropped() const { return dropped; }
+    sf::Vector2f getPosition(std::size_t i) const { return sf::Vector2f(x[i], y[i]); }
 };
\ No newline at end of file
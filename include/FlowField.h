@@ -0,0 +1,46 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+// Flussfeld über eine Spielfeldhälfte: für jede Zelle die Richtung zum
+// nächsten Schritt auf dem kürzesten Weg zum Ziel, um Hindernisse herum.
+// Wird nur neu berechnet, wenn das Ziel die Zelle wechselt, und von allen
+// Gegnern der Hälfte in O(1) abgefragt.
+class FlowField {
+private:
+    static constexpr std::uint32_t UNREACHABLE = 0xFFFFFFFFu;
+
+    float originX, originY;
+    float cellSize;
+    float inverseCellSize;
+    int columns, rows;
+    int targetCell;
+    bool obstacles;
+
+    std::vector<std::uint8_t> blocked;
+    std::vector<std::uint32_t> cost;       // Wegkosten zum Ziel, 10 gerade / 14 diagonal
+    std::vector<std::uint8_t> direct;      // Freie Sicht zum Ziel: direkt ansteuern
+    std::vector<float> directionX, directionY;
+    std::vector<std::uint64_t> open;       // Vorrangwarteschlange (Kosten << 32 | Zelle)
+
+    int column(float x) const { return std::min(std::max(static_cast<int>((x - originX) * inverseCellSize), 0), columns - 1); }
+    int row(float y) const { return std::min(std::max(static_cast<int>((y - originY) * inverseCellSize), 0), rows - 1); }
+    int cellAt(float x, float y) const { return row(y) * columns + column(x); }
+    bool isFree(int c, int r) const;
+    bool lineOfSight(int from, int to) const;
+    void rebuild();
+
+public:
+    FlowField(float left, float top, float width, float height, float cellSize);
+
+    void block(float left, float top, float width, float height);
+    bool update(const sf::Vector2f& target);
+
+    // Abfragen in O(1)
+    bool hasObstacles() const { return obstacles; }
+    bool isDirect(float x, float y) const { return direct[cellAt(x, y)] != 0; }
+    sf::Vector2f getDirection(float x, float y) const;
+};
\ No newline at end of file
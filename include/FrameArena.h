@@ -0,0 +1,31 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+
+// Debug-Builds ersetzen den globalen operator new und zählen jede Heap-Allokation,
+// getrennt je Thread
+#if defined(_DEBUG) && !defined(QT_COUNT_ALLOCATIONS)
+#define QT_COUNT_ALLOCATIONS
+#endif
+
+// Monotoner Speicher für kurzlebige Daten eines Frames (Strings, Hilfslisten).
+// Allokationen verschieben nur einen Zeiger im vorab reservierten Puffer,
+// reset() gibt am Frameanfang alles auf einmal frei.
+class FrameArena {
+private:
+    std::unique_ptr<unsigned char[]> buffer;
+    std::pmr::monotonic_buffer_resource resource;
+
+public:
+    explicit FrameArena(std::size_t capacity);
+
+    void reset();
+    std::pmr::memory_resource* get() { return &resource; }
+};
+
+namespace Memory {
+    // Anzahl globaler Heap-Allokationen des aufrufenden Threads seit dessen
+    // Start, 0 ohne QT_COUNT_ALLOCATIONS
+    std::size_t getThreadAllocationCount();
+}
\ No newline at end of file
@@ -1,52 +1,84 @@
 #pragma once
 #include <SFML/Graphics.hpp>
-#include <vector>
-#include <random>
-#include "Player.h"
-#include "Enemy.h"
-#include "Weapon.h"
-#include "Bullet.h"
+#include <atomic>
+#include <thread>
+#include "Input.h"
+#include "Simulation.h"
+#include "Renderer.h"
+#include "InputPump.h"
+#include "InputCollector.h"
+#include "LatencyStats.h"
+#include "Netplay.h"
+#include "Replay.h"
 
+// Einstellungen für das Spiel mit Fenster
+struct GameOptions {
+    float tickRate = Constants::SIM_TICK_RATE; // Feste Simulationsschritte pro Sekunde
+    const char* latencyFile = nullptr; // CSV-Export der Latenzmessung am Ende, nullptr = keiner
+    const char* recordFile = nullptr;  // Partie aufnehmen, nullptr = nicht aufnehmen
+    const char* replayFile = nullptr;  // Aufnahme wiedergeben statt zu spielen
+    float replaySpeed = 1.0f;          // Wiedergabe als Vielfaches der Echtzeit
+    unsigned long long seekTick = 0;   // Wiedergabe ab diesem Schritt
+    unsigned short hostPort = 0;       // Online-Partie auf diesem Port anbieten, 0 = nicht
+    const char* joinAddress = nullptr; // Online-Partie auf diesem Host beitreten, nullptr = nicht
+    unsigned short joinPort = Constants::NET_DEFAULT_PORT;
+    unsigned int rollbackWindow = Constants::NET_ROLLBACK_WINDOW; // Nur beim Host, gilt für beide
+};
+
+// Fenster, Eingabe und Simulationsschleife auf drei Threads: der
+// Fenster-Thread fragt die Eingabegeräte ab und schreibt Ereignisse in eine
+// Queue, der Simulations-Thread übernimmt sie zu Beginn jedes Schritts und
+// der Renderer zeichnet auf seinem eigenen Thread. Statt der Eingabegeräte
+// kann auch eine Aufnahme die Simulation treiben; darin lässt sich mit den
+// Pfeiltasten spulen und mit P pausieren. In einer Online-Partie steuert
+// jeder Peer einen Spieler, die Sitzung gleicht die Eingaben ab.
 class Game {
 private:
     // Fenster und Rendering
     sf::RenderWindow window;
-    sf::RectangleShape divider;
 
-    // Spielobjekte
-    Player player1, player2;
-    Weapon weapon;
-    std::vector<Enemy> enemies;
-    std::vector<Bullet> bullets;
+    // Wiedergabe; vor simulation, weil sie deren Seed liefert
+    ReplayReader replay;
+    bool replayFinished;
+    bool replayPaused;
+    float replaySpeed;
+
+    // Online-Partie; ebenfalls vor simulation, weil der Host den Seed festlegt
+    NetSession net;
+
+    // Spiellogik
+    Simulation simulation;
+    ReplayWriter recorder;
+    const char* recordFile;
+
+    // Eingabe
+    InputQueue inputEvents;
+    InputPump inputPump;
+    InputCollector inputCollector; // Gehört dem Simulations-Thread
 
-    // Zeit und Spawning
+    // Latenz von der Eingabe bis zum Schritt, der sie übernimmt
+    LatencyStats stepLatency;
+    const char* latencyFile; // CSV-Export am Ende, nullptr = keiner
+
+    // Zeit
     sf::Clock clock;
-    sf::Clock spawnClock;
-    std::mt19937 rng;
-    std::uniform_real_distribution<float> spawnY;
-
-    // UI
-    sf::Font font;
-    sf::Text healthText1, healthText2;
-    sf::Text controlsText;
-    sf::Text gameOverText;
-    std::vector<sf::RectangleShape> healthBars1;
-    std::vector<sf::RectangleShape> healthBars2;
-    bool fontLoaded;
-
-    // Spielzustand
-    bool gameOver;
+    float tickRate;
+
+    Renderer renderer;
+
+    // Simulations-Thread
+    std::thread simulationThread;
+    std::atomic<bool> running;
 
     // Private Methoden
-    void handleEvents();
-    void update();
-    void render();
-    void shoot(Player& player);
-    void restart();
-    void updateControlsText();
-    void initializeUI();
+    void simulationLoop();
+    void update(float dt, std::chrono::steady_clock::time_point tickEnd);
+    void replayStep();
+    void seekReplay(long long ticks);
+    void reportLatency() const;
+    void finishRecording();
 
 public:
-    Game();
+    explicit Game(const GameOptions& options = GameOptions());
     void run();
 };
\ No newline at end of file
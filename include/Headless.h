@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include "Constants.h"
+#include "Input.h"
+
+class Simulation;
+
+// Optionen für den Headless-Modus (ohne Fenster und GPU)
+struct HeadlessOptions {
+    unsigned long long ticks = 100000; // Anzahl Simulationsschritte
+    unsigned int seed = 1;             // Seed für das Spawning
+    float tickRate = Constants::SIM_TICK_RATE; // Simulierte Schritte pro Sekunde Spielzeit
+    std::size_t horde = 0;             // Zusätzliche Gegner bei jedem Start
+    bool invulnerable = false;         // Spieler nehmen keinen Schaden
+    unsigned int threads = 0;          // Threads der Simulation, 0 = alle Hardware-Threads
+    const char* latencyFile = nullptr; // CSV-Export der Latenzmessung, nullptr = keiner
+    const char* recordFile = nullptr;  // Partie aufnehmen, nullptr = nicht aufnehmen
+    const char* replayFile = nullptr;  // Aufnahme wiedergeben statt synthetischer Eingaben
+    unsigned long long seekTick = 0;   // Wiedergabe ab diesem Schritt, über den nächsten Keyframe
+    unsigned short hostPort = 0;       // Online-Partie auf diesem Port anbieten, 0 = nicht
+    const char* joinAddress = nullptr; // Online-Partie auf diesem Host beitreten, nullptr = nicht
+    unsigned short joinPort = Constants::NET_DEFAULT_PORT;
+    unsigned int rollbackWindow = Constants::NET_ROLLBACK_WINDOW; // Nur beim Host, gilt für beide
+};
+
+// Synthetische Eingaben für beide Spieler
+TickInput autopilotInput(const Simulation& simulation, float tickRate);
+
+// Lässt die Simulation mit synthetischen Eingaben so schnell wie möglich laufen
+int runHeadless(const HeadlessOptions& options);
+
+// Spielt eine Aufnahme so schnell wie möglich ab
+int runReplay(const HeadlessOptions& options);
+
+// Spielt eine Online-Partie in Echtzeit, der eigene Spieler mit synthetischen Eingaben
+int runNetplay(const HeadlessOptions& options);
\ No newline at end of file
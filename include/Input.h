@@ -0,0 +1,47 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <chrono>
+#include <cstdint>
+#include "Constants.h"
+#include "SpscQueue.h"
+
+// Eingabe eines Spielers für einen Simulationsschritt
+struct PlayerInput {
+    sf::Vector2f move;        // Bewegungsrichtung, (0,0) = stehen bleiben
+    sf::Vector2f aim;         // Zielrichtung relativ zum Spieler, (0,0) = Rotation behalten
+    bool shoot = false;       // Flanke: in diesem Schritt schießen
+    float shootDelay = 0.0f;  // Anteil des Schritts, der vor dem Schuss schon vergangen war (0..1)
+    bool throwWeapon = false; // Flanke: in diesem Schritt werfen
+};
+
+// Eingaben beider Spieler für einen Simulationsschritt
+struct TickInput {
+    PlayerInput player1;
+    PlayerInput player2;
+};
+
+// Einzelnes Eingabe-Ereignis vom Event-Pump an die Simulation, mit dem
+// Zeitpunkt, zu dem es erkannt wurde. Bewegung und Zielen kommen nur bei
+// Änderungen und gelten bis zum nächsten Ereignis ihrer Art.
+struct InputEvent {
+    enum class Type : std::uint8_t {
+        Shoot,
+        Throw,
+        Move,  // value: Bewegungsrichtung
+        Aim,   // value: Zielrichtung (Stick), (0,0) = Rotation behalten
+        AimAt, // value: Zielpunkt im Spielfeld (Maus)
+        ControllerConnected,
+        ControllerDisconnected,
+        Restart,
+        Seek,  // Nur Wiedergabe, value.x: Sprungweite in Sekunden
+        Pause  // Nur Wiedergabe
+    };
+
+    Type type;
+    std::uint8_t player; // 0 = Spieler 1, 1 = Spieler 2
+    sf::Vector2f value;
+    std::chrono::steady_clock::time_point time;
+};
+
+// Queue vom Event-Pump (Fenster-Thread) zur Simulation
+typedef SpscQueue<InputEvent, Constants::INPUT_QUEUE_SIZE> InputQueue;
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <chrono>
+#include "Input.h"
+
+class Player;
+class Simulation;
+
+// Übernimmt auf dem Simulations-Thread die Eingabe-Ereignisse aus der Queue
+// und baut daraus die Eingabe der einzelnen Schritte. Bewegung und Zielen
+// gelten bis zur nächsten Änderung, Schüsse und Würfe nur für einen Schritt.
+// In einer Online-Partie steuern die Geräte von Spieler 1 den eigenen Spieler.
+class InputCollector {
+private:
+    // Zuletzt gemeldete Bewegung und Zielrichtung eines Spielers
+    struct HeldInput {
+        sf::Vector2f move;
+        sf::Vector2f aim;        // Richtung, oder Zielpunkt bei aimAtPoint
+        bool aimAtPoint = false;
+    };
+
+    InputQueue& queue;
+    HeldInput held[2];
+    bool player1UsesController;
+    int onlinePlayer; // Eigener Spieler einer Online-Partie, -1 = lokales Spiel
+
+    // Ergebnis des letzten collect(): Neustart, ältestes Ereignis für die Latenzmessung
+    bool restarted;
+    bool hasEvents;
+    std::chrono::steady_clock::time_point oldestEvent;
+
+    void applyHeld(const Player& player, const HeldInput& input, PlayerInput& target) const;
+
+public:
+    InputCollector(InputQueue& queue, bool player1UsesController);
+
+    void setOnlinePlayer(int player) { onlinePlayer = player; }
+
+    TickInput collect(Simulation& simulation, float dt, std::chrono::steady_clock::time_point tickEnd);
+
+    bool getRestarted() const { return restarted; }
+    bool getHasEvents() const { return hasEvents; }
+    std::chrono::steady_clock::time_point getOldestEvent() const { return oldestEvent; }
+};
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Input.h"
+#include "Constants.h"
+
+// Liest die Fenster-Events und fragt Tastatur, Maus und Controller ab und
+// schreibt daraus Eingabe-Ereignisse mit Zeitstempel in die Queue. Läuft auf
+// dem Fenster-Thread mit bis zu INPUT_SAMPLE_RATE Abfragen pro Sekunde.
+// Verändert selbst keinen Spielzustand; die Simulation übernimmt die
+// Ereignisse auf ihrem eigenen Thread zu Beginn eines Schritts.
+class InputPump {
+private:
+    // Flankenerkennung der Controller-Tasten und zuletzt gemeldete
+    // Bewegung/Zielrichtung je Spieler
+    struct DeviceState {
+        bool shootHeld = false;
+        bool throwHeld = false;
+        sf::Vector2f move;
+        sf::Vector2f aim;
+        bool aimAtPoint = false;
+    };
+
+    sf::RenderWindow& window;
+    InputQueue& queue;
+    bool usesController[2];
+    unsigned int joystickId[2];
+    DeviceState devices[2];
+
+    bool push(InputEvent::Type type, int player, std::chrono::steady_clock::time_point time, sf::Vector2f value = sf::Vector2f());
+    void sample(int player, std::chrono::steady_clock::time_point time);
+    void sampleController(int player, std::chrono::steady_clock::time_point time);
+    void sampleKeyboardAndMouse(int player, std::chrono::steady_clock::time_point time);
+
+public:
+    InputPump(sf::RenderWindow& window, InputQueue& queue, bool player1UsesController);
+
+    bool pump();
+};
\ No newline at end of file
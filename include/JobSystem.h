@@ -0,0 +1,71 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistenter Thread-Pool mit Work Stealing für datenparallele Schleifen.
+// parallelFor teilt einen Indexbereich in Blöcke fester Größe; jeder Thread
+// arbeitet seine Blöcke von hinten ab und stiehlt bei Leerlauf die vordere
+// Hälfte eines anderen Threads. Die Blockgrenzen hängen nur von count und
+// grain ab, nicht von der Anzahl der Threads: Ergebnisse je Block in eigene
+// Puffer schreiben und danach in Blockreihenfolge zusammenführen, dann ist
+// das Ergebnis unabhängig von der Thread-Anzahl.
+class JobSystem {
+private:
+    struct Task {
+        void (*invoke)(const void* function, std::size_t begin, std::size_t end, std::size_t chunk);
+        const void* function;
+        std::size_t count;
+        std::size_t grain;
+    };
+
+    // Noch offene Blöcke eines Threads: [first, last)
+    struct alignas(64) Queue {
+        std::mutex mutex;
+        std::size_t first = 0, last = 0;
+    };
+
+    unsigned int threadCount; // Inklusive des aufrufenden Threads
+    std::unique_ptr<Queue[]> queues; // Index 0 gehört dem aufrufenden Thread
+    std::vector<std::thread> workers;
+
+    Task task;
+    std::atomic<std::size_t> pending; // Noch nicht fertig bearbeitete Blöcke
+    std::mutex dispatchMutex;         // Immer nur ein parallelFor gleichzeitig
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<unsigned long long> generation; // Zählt verteilte Aufgaben
+    std::atomic<bool> stopping;
+
+    void run(const Task& newTask);
+    bool runChunk(unsigned int self);
+    void workerLoop(unsigned int self);
+
+public:
+    explicit JobSystem(unsigned int threads = 0);
+    ~JobSystem();
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Ruft function(begin, end, chunk) für jeden Block [begin, end) aus
+    // [0, count) auf und kehrt zurück, wenn alle Blöcke fertig sind.
+    template <typename Function>
+    void parallelFor(std::size_t count, std::size_t grain, const Function& function) {
+        Task newTask;
+        newTask.invoke = [](const void* f, std::size_t begin, std::size_t end, std::size_t chunk) {
+            (*static_cast<const Function*>(f))(begin, end, chunk);
+        };
+        newTask.function = &function;
+        newTask.count = count;
+        newTask.grain = grain > 0 ? grain : 1;
+        run(newTask);
+    }
+
+    static std::size_t chunkCount(std::size_t count, std::size_t grain) { return (count + grain - 1) / grain; }
+    unsigned int getThreadCount() const { return threadCount; }
+};
\ No newline at end of file
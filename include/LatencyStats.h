@@ -0,0 +1,36 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+#include "Constants.h"
+
+// Kennzahlen einer Latenzmessung in Millisekunden
+struct LatencySummary {
+    std::size_t count;
+    double p50, p90, p99, max;
+};
+
+// Sammelt Latenzen an einem Messpunkt der Eingabe-Kette (z.B. Eingabe bis
+// Schritt). Fester Ringpuffer, das Aufzeichnen allokiert nie; auswerten erst
+// am Ende. Gehört genau einem Thread.
+class LatencyStats {
+private:
+    std::vector<float> samples; // Millisekunden
+    std::size_t capacity;
+    std::size_t next;
+    std::size_t recorded;
+
+public:
+    explicit LatencyStats(std::size_t capacity = Constants::LATENCY_SAMPLE_COUNT);
+
+    void record(std::chrono::steady_clock::duration latency);
+    void clear();
+
+    LatencySummary summarize() const;
+    void print(std::ostream& out, const char* stage) const;
+    void writeCsvRow(std::ostream& out, const char* stage) const;
+    static void writeCsvHeader(std::ostream& out);
+
+    std::size_t getRecorded() const { return recorded; }
+};
\ No newline at end of file
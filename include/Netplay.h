@@ -0,0 +1,91 @@
+#pragma once
+#include <SFML/Network.hpp>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+#include "Constants.h"
+#include "Input.h"
+#include "SimulationState.h"
+
+class Simulation;
+
+// Einstellungen einer Online-Partie; der Host legt sie fest und schickt sie
+// beim Verbinden an den Mitspieler
+struct NetSettings {
+    std::uint32_t seed = 0;
+    float tickRate = Constants::SIM_TICK_RATE;
+    std::uint64_t horde = 0;      // Zusätzliche Gegner bei jedem Start
+    bool invulnerable = false;
+    std::uint32_t rollbackWindow = Constants::NET_ROLLBACK_WINDOW;
+};
+
+// Online-Koop zweier Peers über UDP mit Rollback. Jeder Peer steuert einen
+// Spieler (Host = Spieler 1) und simuliert sofort mit seiner eigenen
+// Eingabe; die des Mitspielers wird vorhergesagt: Bewegung und Zielen wie
+// zuletzt bekannt, keine Schüsse und Würfe. Weicht eine eintreffende Eingabe
+// davon ab, wird der Stand vor diesem Schritt wiederhergestellt und bis zum
+// aktuellen Schritt neu simuliert. Ein Peer läuft höchstens rollbackWindow
+// Schritte über die letzte bekannte Eingabe des Mitspielers hinaus, danach
+// wartet er. Jedes Paket wiederholt alle noch nicht bestätigten Eingaben,
+// verlorene Pakete brauchen deshalb keine eigene Behandlung.
+class NetSession {
+private:
+    // Eingaben beider Spieler für einen Schritt
+    struct TickInputs {
+        PlayerInput input[2];
+        bool restart[2] = { false, false }; // Neustart, wirkt nur nach Spielende
+    };
+
+    sf::UdpSocket socket;
+    sf::IpAddress peerAddress;
+    unsigned short peerPort;
+    bool connected;
+    bool peerLost;
+    int localPlayer;
+    NetSettings settings;
+
+    std::vector<TickInputs> inputs;      // Ringpuffer über die Schritte
+    std::vector<SimulationState> states; // Stand vor dem Schritt, Ringpuffer
+    std::uint64_t tick;                  // Nächster zu simulierender Schritt
+    std::uint64_t remoteTicks;           // Eingaben des Mitspielers lückenlos bekannt bis hier (exklusiv)
+    std::uint64_t peerAcked;             // Eigene Eingaben, die der Mitspieler bestätigt hat
+    std::uint64_t firstMispredicted;     // Frühester falsch vorhergesagter Schritt
+    sf::Clock sinceReceive;
+    sf::Packet incoming, outgoing; // Wiederverwendet, damit Senden und Empfangen nicht allokieren
+
+    // Statistik
+    unsigned long long rollbacks;
+    unsigned long long resimulatedTicks;
+    unsigned long long maxRollbackTicks;
+    double maxRollbackMs;
+    unsigned long long waits;
+
+    void start(const NetSettings& newSettings, int player);
+    void sendWelcome();
+    void receive();
+    void receiveInputs(sf::Packet& packet);
+    void send();
+    void rollback(Simulation& simulation);
+    void simulate(Simulation& simulation, std::uint64_t t);
+    PlayerInput predict() const;
+    TickInputs& slot(std::uint64_t t) { return inputs[t % inputs.size()]; }
+
+public:
+    NetSession();
+
+    bool host(unsigned short port, const NetSettings& hostSettings);
+    bool join(const sf::IpAddress& address, unsigned short port);
+
+    void synchronize(Simulation& simulation);
+    bool canAdvance() const;
+    void advance(Simulation& simulation, const PlayerInput& input, bool restart);
+    void printStats(std::ostream& out) const;
+
+    bool isConnected() const { return connected; }
+    bool isPeerLost() const { return peerLost; }
+    int getLocalPlayer() const { return localPlayer; }
+    const NetSettings& getSettings() const { return settings; }
+    std::uint64_t getTick() const { return tick; }
+    std::uint64_t getConfirmedTick() const { return remoteTicks < tick ? remoteTicks : tick; }
+    std::uint64_t getPeerAcked() const { return peerAcked; }
+};
\ No newline at end of file
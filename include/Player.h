@@ -1,13 +1,15 @@
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
 #include "Constants.h"
+#include "Input.h"
 
+// Ohne Zeiger und Ressourcen, wird im Spielstand als Ganzes kopiert
 class Player {
 private:
-    sf::CircleShape shape;
-    sf::RectangleShape directionIndicator;
     sf::Vector2f position;
     float rotation;
+    sf::Vector2f previousPosition; // Vorheriger Schritt, zum Interpolieren beim Zeichnen
+    float previousRotation;
     int health;
     bool hasWeapon;
     bool isControllerPlayer;
@@ -16,16 +18,18 @@ private:
 public:
     Player(float x, float y, bool useController, int joyId = 0);
 
-    void update(float dt, sf::RenderWindow& window);
+    void update(float dt, const PlayerInput& input);
     void takeDamage();
-    void draw(sf::RenderWindow& window);
 
     // Getter
     bool isAlive() const { return health > 0; }
     sf::Vector2f getPosition() const { return position; }
+    sf::Vector2f getPreviousPosition() const { return previousPosition; }
     float getRotation() const { return rotation; }
+    float getPreviousRotation() const { return previousRotation; }
     bool getHasWeapon() const { return hasWeapon; }
     int getHealth() const { return health; }
+    int getJoystickId() const { return joystickId; }
     bool getIsControllerPlayer() const { return isControllerPlayer; }
     sf::Vector2f getAimDirection() const;
 
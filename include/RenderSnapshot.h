@@ -0,0 +1,65 @@
+#pragma once
+#include <SFML/System/Vector2.hpp>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+class Simulation;
+
+// Spieler oder Waffe: vorheriger und aktueller Schritt zum Interpolieren
+struct BodyView {
+    sf::Vector2f previousPosition, position;
+    float previousRotation, rotation;
+};
+
+// Erfassungszeit der ältesten Eingabe einer Menge von Eingaben
+struct InputStamp {
+    bool valid = false;
+    std::chrono::steady_clock::time_point time;
+
+    void include(std::chrono::steady_clock::time_point other) {
+        if (!valid || other < time) {
+            time = other;
+        }
+        valid = true;
+    }
+    void include(const InputStamp& other) {
+        if (other.valid) {
+            include(other.time);
+        }
+    }
+};
+
+// Alles, was der Render-Thread von einem Simulationsschritt braucht. Wird vom
+// Simulations-Thread gefüllt und über einen TripleBuffer übergeben, danach
+// nur noch gelesen.
+struct RenderSnapshot {
+    BodyView players[2];
+    BodyView weapon;
+    int health[2];
+    bool player1UsesController;
+    bool gameOver;
+
+    // Gegner und Kugeln beider Hälften hintereinander
+    std::vector<float> enemyX, enemyY, enemyVX, enemyVY;
+    std::vector<float> bulletX, bulletY, bulletVX, bulletVY;
+
+    // Wanduhrzeit, zu der der letzte Schritt fällig war, und Schrittdauer;
+    // simulierte Schrittdauer für die Geschwindigkeiten, bei der Wiedergabe
+    // nicht gleich der Wanduhr-Dauer
+    std::chrono::steady_clock::time_point stepTime;
+    float tickTime;
+    float dt;
+
+    // Latenzmessung: laufende Nummer des Stands, älteste Eingabe seit dem
+    // vorigen Stand und älteste seit dem letzten sicher gelesenen Stand (für
+    // den Fall, dass der Render-Thread Stände überspringt)
+    std::uint64_t sequence;
+    InputStamp input;
+    InputStamp unshownInput;
+
+    RenderSnapshot();
+
+    void capture(const Simulation& simulation, std::chrono::steady_clock::time_point dueTime, float tickSeconds, float stepSeconds);
+    float getAlpha(std::chrono::steady_clock::time_point now) const;
+};
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include "RenderSnapshot.h"
+#include "TripleBuffer.h"
+#include "FrameArena.h"
+#include "LatencyStats.h"
+
+class Simulation;
+
+// Zeichnet auf einem eigenen Thread. Der Simulations-Thread veröffentlicht
+// nach seinen Schritten einen RenderSnapshot, der Render-Thread zeichnet
+// immer den neuesten. Blockiert der Treiber in display(), läuft die
+// Simulation weiter; ein langsamer Schritt hält das Zeichnen nicht auf.
+class Renderer {
+private:
+    sf::RenderWindow& window;
+    TripleBuffer<RenderSnapshot> snapshots;
+    std::thread thread;
+    std::atomic<bool> running;
+
+    // Latenzmessung. Veröffentlichte Stände und ihre Eingaben gehören dem
+    // Simulations-Thread, der Rest dem Render-Thread.
+    std::uint64_t publishedSequence;
+    InputStamp pendingInput;     // Seit dem letzten publish()
+    InputStamp unconfirmedInput; // Seit dem letzten Stand, der sicher gelesen wurde
+    std::uint64_t shownSequence;
+    LatencyStats displayLatency; // Von der Eingabe bis zum ersten Bild, das sie zeigt
+
+    // Formen
+    sf::RectangleShape divider;
+    sf::CircleShape playerShape;
+    sf::RectangleShape directionIndicator;
+    sf::RectangleShape weaponShape;
+    sf::VertexArray enemyVertices;  // Wird jeden Frame aus dem Snapshot erzeugt
+    sf::VertexArray bulletVertices;
+
+    // Speicher für kurzlebige Daten, wird jeden Frame zurückgesetzt
+    FrameArena frameArena;
+
+    // UI
+    sf::Font font;
+    sf::Text healthText1, healthText2;
+    sf::Text controlsText;
+    sf::Text gameOverText;
+    sf::Text restartText;
+    int shownHealth1, shownHealth2; // Zuletzt angezeigte Werte, Text nur bei Änderung neu setzen
+    int shownControls;              // Zuletzt angezeigte Steuerung: 1 = Controller, 0 = Tastatur
+    std::vector<sf::RectangleShape> healthBars1;
+    std::vector<sf::RectangleShape> healthBars2;
+    bool fontLoaded;
+
+    // Private Methoden
+    void initializeUI();
+    void updateControlsText(bool player1UsesController);
+    void updateHealthText(sf::Text& text, const char* label, int health, int& shownHealth);
+    void drawPlayer(const BodyView& player, float alpha);
+    void render(const RenderSnapshot& snapshot, float alpha);
+    void renderLoop();
+    void recordDisplayLatency(const RenderSnapshot& snapshot);
+
+public:
+    explicit Renderer(sf::RenderWindow& window);
+    ~Renderer();
+
+    void addInput(std::chrono::steady_clock::time_point captureTime);
+    void publish(const Simulation& simulation, std::chrono::steady_clock::time_point dueTime, float tickTime, float dt);
+    void start();
+    void stop();
+
+    // Erst nach stop() lesen
+    const LatencyStats& getDisplayLatency() const { return displayLatency; }
+};
\ No newline at end of file
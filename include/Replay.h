@@ -0,0 +1,109 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <vector>
+#include "Input.h"
+#include "SimulationState.h"
+
+class Simulation;
+
+// Alles, was eine Aufnahme außer den Eingaben braucht, um eine Partie exakt
+// nachzuspielen
+struct ReplayHeader {
+    std::uint32_t seed = 0;
+    float tickRate = 0.0f;
+    std::uint64_t horde = 0;        // Zusätzliche Gegner bei jedem Start
+    bool invulnerable = false;
+    bool player1UsesController = false;
+    std::uint32_t keyframeInterval = Constants::REPLAY_KEYFRAME_INTERVAL; // Schritte zwischen zwei Keyframes, 0 = keine
+};
+
+// Ein aufgenommener Simulationsschritt
+struct ReplayTick {
+    TickInput input;
+    bool restart = false;               // Vor dem Schritt neu starten
+    bool player1UsesController = false;
+};
+
+// Eintrag im Index am Ende einer Aufnahme
+struct ReplayKeyframe {
+    std::uint64_t tick = 0;   // Anzahl Schritte vor dem Keyframe
+    std::uint64_t offset = 0; // Position in der Datei
+};
+
+// Schreibt eine Aufnahme: Kopf, dann je Schritt ein Flag-Byte und nur die
+// Werte, die sich gegenüber dem vorigen Schritt geändert haben. Ein Schritt
+// ohne Änderungen und ohne Aktionen kostet ein Byte.
+// Alle keyframeInterval Schritte folgt ein Keyframe mit dem vollständigen
+// Spielstand, ab dem die Werte wieder vollständig geschrieben werden. Am
+// Ende steht ein Index der Keyframes, über den ReplayReader springen kann.
+class ReplayWriter {
+private:
+    std::ofstream out;
+    ReplayTick last;
+    std::uint32_t keyframeInterval;
+    std::uint64_t ticks;
+    std::vector<ReplayKeyframe> index;
+    SimulationState keyframeState;
+
+    template <typename T>
+    void put(const T& value) { out.write(reinterpret_cast<const char*>(&value), sizeof(T)); }
+
+    void writeKeyframe(const Simulation& simulation);
+
+public:
+    ReplayWriter();
+
+    bool open(const char* path, const ReplayHeader& header, const Simulation& simulation);
+    void write(const ReplayTick& tick, const Simulation& simulation);
+    bool close();
+
+    bool isOpen() const { return out.is_open(); }
+};
+
+// Liest eine Aufnahme von ReplayWriter Schritt für Schritt und springt über
+// die Keyframes zu beliebigen Schritten
+class ReplayReader {
+private:
+    std::ifstream in;
+    ReplayHeader header;
+    ReplayTick last;
+    std::uint64_t position;  // Leseposition in der Datei
+    std::uint64_t dataEnd;   // Beginn des Index, ohne Index das Dateiende
+    std::uint64_t ticksRead;
+    std::uint64_t totalTicks;
+    bool keyframePending;    // Vor dem nächsten Schritt steht ein Keyframe
+    std::vector<ReplayKeyframe> index;
+    SimulationState keyframeState;
+    SimulationState seekFallback; // Stand vor einem Sprung, falls er scheitert
+
+    template <typename T>
+    bool get(T& value) {
+        position += sizeof(T);
+        return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+    }
+
+    bool readIndex();
+    bool skipKeyframe();
+    bool seekTo(Simulation& simulation, std::uint64_t tick);
+
+public:
+    ReplayReader();
+
+    bool open(const char* path);
+    bool read(ReplayTick& tick);
+    bool seek(Simulation& simulation, std::uint64_t tick);
+
+    bool isOpen() const { return in.is_open(); }
+    bool hasIndex() const { return !index.empty(); }
+    const ReplayHeader& getHeader() const { return header; }
+    std::uint64_t getTick() const { return ticksRead; }
+    std::uint64_t getTotalTicks() const { return totalTicks; }
+};
+
+// Spielt einen aufgenommenen Schritt in die Simulation ein
+void applyReplayTick(Simulation& simulation, const ReplayHeader& header, const ReplayTick& tick);
+
+// Prüfsumme über den Spielzustand, um Aufnahme und Wiedergabe zu vergleichen
+std::uint64_t stateChecksum(const Simulation& simulation);
\ No newline at end of file
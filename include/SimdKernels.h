@@ -0,0 +1,39 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Gebündelte Kernel für die Bewegung aller Gegner und Kugeln über flache
+// float-Arrays. Die Befehlssatzstufe wird beim Start einmal erkannt, ohne
+// SSE/AVX2 läuft die skalare Variante. Alle Stufen rechnen dieselben
+// Operationen in derselben Reihenfolge und liefern identische Ergebnisse.
+namespace Simd {
+    enum class Level { Scalar, SSE, AVX2 };
+
+    // Statusbits von advanceBullets
+    const std::uint8_t BULLET_OUT_OF_BOUNDS = 1 << 0;
+    const std::uint8_t BULLET_PAST_STOP = 1 << 1;
+
+    Level detectLevel();
+    Level getLevel();
+    void setLevel(Level level); // Wird auf die erkannte Stufe begrenzt
+    const char* getLevelName(Level level);
+
+    // Bewegt alle Gegner mit speed auf das Ziel zu und speichert ihre Geschwindigkeit
+    void seek(float* x, float* y, float* vx, float* vy, std::size_t count,
+        float targetX, float targetY, float speed, float dt);
+
+    // Normalisiert alle Vektoren (x[i], y[i]) an Ort und Stelle, mit denselben
+    // Rechenschritten wie Utils::fastNormalize; Nullvektoren bleiben null
+    void normalize(float* x, float* y, std::size_t count);
+
+    // Setzt in mask Bit i (Wort i / 64, Bit i % 64) für jeden Punkt, der strikt
+    // innerhalb des Kreises liegt. Vergleicht quadrierte Abstände, ohne Wurzel.
+    // mask muss (count + 63) / 64 Wörter fassen.
+    void overlapMask(const float* x, const float* y, std::size_t count,
+        float centerX, float centerY, float radius, std::uint64_t* mask);
+
+    // Bewegt alle Kugeln und setzt je Kugel die Statusbits: außerhalb von
+    // [0, width] x [0, height] bzw. Haltelinie stopX erreicht (stopRight: x >= stopX, sonst x <= stopX)
+    void advanceBullets(float* x, float* y, const float* vx, const float* vy, std::uint8_t* status,
+        std::size_t count, float dt, float width, float height, float stopX, bool stopRight);
+}
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+#include <random>
+#include "Input.h"
+#include "Player.h"
+#include "Weapon.h"
+#include "ArenaHalf.h"
+#include "JobSystem.h"
+
+class SimulationState;
+
+// Fensterlose Spiellogik: Spieler, Waffe, Gegner, Kugeln und Spawning.
+// Wird von Game mit Geräte-Eingaben und im Headless-Modus mit
+// synthetischen Eingaben Schritt für Schritt vorangetrieben.
+class Simulation {
+private:
+    // Spielobjekte
+    Player player1, player2;
+    Weapon weapon;
+    ArenaHalf halves[2]; // 0 = links (Spieler 1), 1 = rechts (Spieler 2)
+
+    // Threads für die datenparallelen Durchläufe
+    JobSystem jobs;
+
+    // Spawning
+    unsigned int seed;
+    std::mt19937 rng;
+    std::uniform_real_distribution<float> spawnY;
+    float spawnTimer;
+
+    // Stresstests
+    bool invulnerable; // Spieler nehmen keinen Schaden
+
+    // Spielzustand
+    bool gameOver;
+    unsigned long long tickCount;
+
+    // Private Methoden
+    void applyActions(Player& player, int playerIndex, const Player& partner, const PlayerInput& input, float dt);
+    void shoot(Player& player, float delay, float dt);
+    void spawnEnemies();
+    bool shouldRunHalvesInParallel() const;
+
+public:
+    Simulation(unsigned int seed, bool player1UsesController, unsigned int threads = 0);
+
+    void step(float dt, const TickInput& input);
+    void restart(bool player1UsesController);
+    void spawnHorde(std::size_t count);
+    void addObstacle(float left, float top, float width, float height);
+    void setInvulnerable(bool value) { invulnerable = value; }
+
+    // Spielstand: alles, was spätere Schritte beeinflusst
+    void saveState(SimulationState& state) const;
+    bool loadState(const SimulationState& state);
+
+    // Getter
+    Player& getPlayer1() { return player1; }
+    Player& getPlayer2() { return player2; }
+    const Player& getPlayer1() const { return player1; }
+    const Player& getPlayer2() const { return player2; }
+    const Weapon& getWeapon() const { return weapon; }
+    Weapon& getWeapon() { return weapon; }
+    const ArenaHalf& getHalf(std::size_t i) const { return halves[i]; }
+    std::size_t getEnemyCount() const { return halves[0].enemies.size() + halves[1].enemies.size(); }
+    std::size_t getBulletCount() const { return halves[0].bullets.size() + halves[1].bullets.size(); }
+    bool isGameOver() const { return gameOver; }
+    unsigned long long getTickCount() const { return tickCount; }
+    unsigned int getSeed() const { return seed; }
+};
\ No newline at end of file
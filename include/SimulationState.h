@@ -0,0 +1,102 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+// Spielstand einer Simulation als flacher Speicherblock ohne Zeiger. Objekte
+// werden als Ganzes byteweise hineinkopiert, Gegner und Kugeln als Arrays
+// (Länge, dann die Elemente); Sichern und Wiederherstellen sind damit nur
+// memcpy. Der Puffer wächst nur, wenn ein Stand größer ist als alle
+// bisherigen, und lässt sich unverändert in Dateien schreiben.
+// Byte-Reihenfolge des Rechners.
+class SimulationState {
+private:
+    std::vector<unsigned char> bytes;
+    std::size_t length;
+
+public:
+    SimulationState() : length(0) {}
+
+    void clear() { length = 0; }
+
+    void append(const void* data, std::size_t size) {
+        if (length + size > bytes.size()) {
+            bytes.resize(std::max(length + size, 2 * bytes.size()));
+        }
+        if (size > 0) {
+            std::memcpy(bytes.data() + length, data, size);
+        }
+        length += size;
+    }
+
+    template <typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Spielstand darf nur flache Daten enthalten");
+        append(&value, sizeof(T));
+    }
+
+    // Länge, dann die Elemente
+    template <typename T>
+    void writeArray(const std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "Spielstand darf nur flache Daten enthalten");
+        write(static_cast<std::uint64_t>(values.size()));
+        append(values.data(), values.size() * sizeof(T));
+    }
+
+    // Zum Einlesen aus Dateien: Platz für size Bytes, die der Aufrufer füllt
+    unsigned char* resize(std::size_t size) {
+        if (size > bytes.size()) {
+            bytes.resize(size);
+        }
+        length = size;
+        return bytes.data();
+    }
+
+    const unsigned char* data() const { return bytes.data(); }
+    std::size_t size() const { return length; }
+};
+
+// Liest einen SimulationState von vorn in der Reihenfolge, in der er
+// geschrieben wurde
+class StateReader {
+private:
+    const SimulationState& state;
+    std::size_t position;
+
+public:
+    explicit StateReader(const SimulationState& state) : state(state), position(0) {}
+
+    bool take(void* data, std::size_t size) {
+        if (size > state.size() - position) {
+            return false;
+        }
+        if (size > 0) {
+            std::memcpy(data, state.data() + position, size);
+        }
+        position += size;
+        return true;
+    }
+
+    template <typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Spielstand darf nur flache Daten enthalten");
+        return take(&value, sizeof(T));
+    }
+
+    // Behält die Kapazität des Vektors, wenn sie reicht
+    template <typename T>
+    bool readArray(std::vector<T>& values) {
+        static_assert(std::is_trivially_copyable<T>::value, "Spielstand darf nur flache Daten enthalten");
+        std::uint64_t size = 0;
+        if (!read(size) || size > (state.size() - position) / sizeof(T)) {
+            return false;
+        }
+        values.resize(static_cast<std::size_t>(size));
+        return take(values.data(), values.size() * sizeof(T));
+    }
+
+    bool atEnd() const { return position == state.size(); }
+};
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <algorithm>
+
+// Gleichmäßiges Gitter über das Spielfeld für Nachbarschaftsabfragen.
+// Wird jeden Schritt aus den Positionen neu aufgebaut (Counting Sort),
+// die Indizes einer Zelle liegen danach zusammenhängend in entries.
+class SpatialGrid {
+private:
+    float originX, originY;
+    float cellSize;
+    float inverseCellSize;
+    int columns, rows;
+    std::vector<std::uint32_t> cellStart; // Zelle c: entries[cellStart[c] .. cellStart[c + 1])
+    std::vector<std::uint32_t> entries;
+    std::vector<std::uint32_t> entryCell;
+    std::vector<float> cellSumX, cellSumY; // Summe der Positionen je Zelle
+
+    int column(float x) const { return std::min(std::max(static_cast<int>((x - originX) * inverseCellSize), 0), columns - 1); }
+    int row(float y) const { return std::min(std::max(static_cast<int>((y - originY) * inverseCellSize), 0), rows - 1); }
+
+public:
+    SpatialGrid(float left, float top, float width, float height, float cellSize);
+
+    void reserve(std::size_t count);
+    void build(const std::vector<float>& x, const std::vector<float>& y);
+
+    // Ruft visit(index) für alle Einträge in Zellen auf, die den Kreis berühren.
+    // Innerhalb einer Zelle in aufsteigender Index-Reihenfolge.
+    template <typename Visitor>
+    void query(float x, float y, float radius, Visitor&& visit) const {
+        int minColumn = column(x - radius), maxColumn = column(x + radius);
+        int minRow = row(y - radius), maxRow = row(y + radius);
+
+        for (int r = minRow; r <= maxRow; r++) {
+            for (int c = minColumn; c <= maxColumn; c++) {
+                int cell = r * columns + c;
+                for (std::uint32_t k = cellStart[cell]; k < cellStart[cell + 1]; k++) {
+                    visit(entries[k]);
+                }
+            }
+        }
+    }
+
+    // Anzahl und Positionssumme aller Einträge in den Zellen, die den Kreis
+    // berühren, ohne die Einträge einzeln zu besuchen
+    std::uint32_t sumAround(float x, float y, float radius, float& sumX, float& sumY) const {
+        int minColumn = column(x - radius), maxColumn = column(x + radius);
+        int minRow = row(y - radius), maxRow = row(y + radius);
+
+        std::uint32_t count = 0;
+        sumX = 0.0f;
+        sumY = 0.0f;
+        for (int r = minRow; r <= maxRow; r++) {
+            for (int c = minColumn; c <= maxColumn; c++) {
+                int cell = r * columns + c;
+                count += cellStart[cell + 1] - cellStart[cell];
+                sumX += cellSumX[cell];
+                sumY += cellSumY[cell];
+            }
+        }
+        return count;
+    }
+
+    float getCellSize() const { return cellSize; }
+};
\ No newline at end of file
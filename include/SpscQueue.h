@@ -0,0 +1,44 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+// Sperrfreier Ringpuffer für genau einen Produzenten und genau einen
+// Konsumenten. Capacity muss eine Zweierpotenz sein. Ein voller Puffer
+// weist neue Einträge ab, statt zu warten.
+template <typename T, std::size_t Capacity>
+class SpscQueue {
+private:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity muss eine Zweierpotenz sein");
+
+    T items[Capacity];
+    alignas(64) std::atomic<std::size_t> head; // Nächster zu lesender Eintrag, gehört dem Konsumenten
+    alignas(64) std::atomic<std::size_t> tail; // Nächster freier Platz, gehört dem Produzenten
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // Produzent
+    bool push(const T& item) {
+        std::size_t position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[position & (Capacity - 1)] = item;
+        tail.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Konsument: ältester Eintrag oder nullptr, ohne ihn zu entfernen
+    const T* front() const {
+        std::size_t position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &items[position & (Capacity - 1)];
+    }
+
+    // Konsument: ältesten Eintrag entfernen, nur nach erfolgreichem front()
+    void pop() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+};
\ No newline at end of file
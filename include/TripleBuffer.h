@@ -0,0 +1,41 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Sperrfreie Übergabe von Zuständen von genau einem Schreiber an genau einen
+// Leser. Der Schreiber füllt den hinteren Puffer und tauscht ihn mit dem
+// mittleren, der Leser holt sich den mittleren, wenn er neu ist. Keine Seite
+// wartet je auf die andere; der Leser sieht immer den neuesten fertigen Stand.
+template <typename T>
+class TripleBuffer {
+private:
+    static const std::uint8_t INDEX_MASK = 3;
+    static const std::uint8_t FRESH = 4; // Mittlerer Puffer seit dem letzten Lesen neu
+
+    T slots[3];
+    std::atomic<std::uint8_t> middle;
+    std::uint8_t back;  // Gehört dem Schreiber
+    std::uint8_t front; // Gehört dem Leser
+
+public:
+    TripleBuffer() : middle(1), back(0), front(2) {}
+
+    // Schreiber: Puffer füllen, dann veröffentlichen. Liefert false, wenn
+    // der dabei verdrängte Stand nie gelesen wurde.
+    T& getBack() { return slots[back]; }
+    bool publish() {
+        std::uint8_t previous = middle.exchange(static_cast<std::uint8_t>(back | FRESH), std::memory_order_acq_rel);
+        back = previous & INDEX_MASK;
+        return !(previous & FRESH);
+    }
+
+    // Leser: neuesten Stand übernehmen, falls es einen gibt
+    bool acquire() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+    const T& getFront() const { return slots[front]; }
+};
\ No newline at end of file
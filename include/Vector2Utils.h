@@ -1,6 +1,8 @@
 #pragma once
 #include <SFML/System/Vector2.hpp>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
 
 namespace Utils {
     const float PI = 3.14159265f;
@@ -18,6 +20,21 @@ namespace Utils {
         return std::sqrt(dx * dx + dy * dy);
     }
 
+    inline float lengthSquared(const sf::Vector2f& v) {
+        return v.x * v.x + v.y * v.y;
+    }
+
+    inline float distanceSquared(const sf::Vector2f& a, const sf::Vector2f& b) {
+        float dx = a.x - b.x;
+        float dy = a.y - b.y;
+        return dx * dx + dy * dy;
+    }
+
+    // Ob a und b weniger als radius voneinander entfernt sind, ohne Wurzel
+    inline bool isWithin(const sf::Vector2f& a, const sf::Vector2f& b, float radius) {
+        return distanceSquared(a, b) < radius * radius;
+    }
+
     inline float toDegrees(float radians) {
         return radians * 180.0f / PI;
     }
@@ -25,4 +42,96 @@ namespace Utils {
     inline float toRadians(float degrees) {
         return degrees * PI / 180.0f;
     }
+
+    // Anteil t in [0, 1] der Strecke start -> end, bei dem ein Punkt erstmals in den
+    // Kreis um center eindringt. 0 wenn er schon drin liegt, -1 wenn er ihn verfehlt.
+    inline float sweepCircle(const sf::Vector2f& start, const sf::Vector2f& end, const sf::Vector2f& center, float radius) {
+        sf::Vector2f d = end - start;
+        sf::Vector2f m = start - center;
+        float c = m.x * m.x + m.y * m.y - radius * radius;
+        if (c <= 0) return 0.0f;
+
+        float a = d.x * d.x + d.y * d.y;
+        float b = m.x * d.x + m.y * d.y;
+        if (a == 0 || b >= 0) return -1.0f; // Kein Weg oder bewegt sich weg
+
+        float discriminant = b * b - a * c;
+        if (discriminant < 0) return -1.0f;
+
+        float t = (-b - std::sqrt(discriminant)) / a;
+        return t <= 1.0f ? t : -1.0f;
+    }
+
+    inline sf::Vector2f lerp(const sf::Vector2f& a, const sf::Vector2f& b, float t) {
+        return a + (b - a) * t;
+    }
+
+    // Interpoliert Winkel in Grad über den kürzeren Weg (z.B. 170° -> -170°)
+    inline float lerpAngle(float a, float b, float t) {
+        float delta = std::fmod(b - a + 540.0f, 360.0f) - 180.0f;
+        return a + delta * t;
+    }
+
+    // Schnelle Näherungen. Sie rechnen nur mit Grundrechenarten und Ganzzahl-
+    // Operationen, ohne Bibliotheksaufrufe, deren Ergebnis von der Plattform
+    // abhängt. Die Fehlergrenzen prüft --bench math.
+    const float RSQRT_MAX_REL_ERROR = 5e-6f;  // Für normalisierte x > 0
+    const float SINCOS_MAX_ERROR = 5e-7f;     // Absolut, für |radians| <= 2 PI
+    const float ATAN2_MAX_ERROR = 2.5e-6f;    // Absolut in Bogenmaß
+
+    // 1 / sqrt(x): Startwert über die Bitdarstellung, dann zwei Newton-Schritte.
+    // Für x = 0 ein großer endlicher Wert, sodass 0 * rsqrt(0) = 0 bleibt.
+    inline float rsqrt(float x) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &x, sizeof(float));
+        bits = 0x5f375a86u - (bits >> 1);
+        float y;
+        std::memcpy(&y, &bits, sizeof(float));
+
+        float half = 0.5f * x;
+        y = y * (1.5f - half * y * y);
+        y = y * (1.5f - half * y * y);
+        return y;
+    }
+
+    // Wie normalize, aber ohne Wurzel und Division; der Nullvektor bleibt null.
+    // Für ganze Arrays gebündelt: Simd::normalize
+    inline sf::Vector2f fastNormalize(const sf::Vector2f& v) {
+        return v * rsqrt(lengthSquared(v));
+    }
+
+    // Sinus und Kosinus zusammen: Reduktion auf [-PI/4, PI/4], dann Taylor-Polynome
+    inline void sinCos(float radians, float& sine, float& cosine) {
+        float scaled = radians * (2.0f / PI);
+        int quadrant = static_cast<int>(scaled + (scaled < 0 ? -0.5f : 0.5f));
+        // PI/2 in zwei Teilen, damit die Reduktion genau bleibt
+        float r = radians - quadrant * 1.57079637f;
+        r = r + quadrant * 4.37113883e-8f;
+
+        float r2 = r * r;
+        float s = r + r * r2 * (-1.0f / 6.0f + r2 * (1.0f / 120.0f + r2 * (-1.0f / 5040.0f)));
+        float c = 1.0f + r2 * (-0.5f + r2 * (1.0f / 24.0f + r2 * (-1.0f / 720.0f + r2 * (1.0f / 40320.0f))));
+
+        // Quadrant ohne Sprünge einrechnen: ungerade tauscht, 2 und 3 spiegeln
+        float sineBase = (quadrant & 1) ? c : s;
+        float cosineBase = (quadrant & 1) ? s : c;
+        sine = (quadrant & 2) ? -sineBase : sineBase;
+        cosine = ((quadrant + 1) & 2) ? -cosineBase : cosineBase;
+    }
+
+    // atan2 über ein Minimax-Polynom auf [0, 1] und Spiegelung in die Oktanten
+    inline float fastAtan2(float y, float x) {
+        float ax = std::fabs(x);
+        float ay = std::fabs(y);
+        float largest = ax > ay ? ax : ay;
+        if (largest == 0) return 0.0f;
+
+        float a = (ax > ay ? ay : ax) / largest;
+        float s = a * a;
+        float r = a * (0.99997726f + s * (-0.33262347f + s * (0.19354346f + s * (-0.11643287f + s * (0.05265332f + s * -0.01172120f)))));
+
+        if (ay > ax) r = 1.57079637f - r;
+        if (x < 0) r = 3.14159274f - r;
+        return y < 0 ? -r : r;
+    }
 }
\ No newline at end of file
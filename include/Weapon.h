@@ -1,24 +1,35 @@
 #pragma once
-#include <SFML/Graphics.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstdint>
 #include "Player.h"
 
+// Träger werden als Spielerindex (0 oder 1) gespeichert, nicht als Zeiger,
+// damit die Waffe im Spielstand als Ganzes kopiert werden kann
 class Weapon {
 private:
-    sf::RectangleShape shape;
     sf::Vector2f position;
     sf::Vector2f velocity;
+    float rotation;
+    sf::Vector2f previousPosition;
+    float previousRotation;
     bool isFlying;
-    Player* holder;
-    Player* lastHolder;  // Neues Feld: Wer hat zuletzt geworfen
-    float throwCooldown; // Neues Feld: Cooldown-Timer
+    std::int8_t holder;     // Index des Spielers, NO_HOLDER = niemand
+    std::int8_t lastHolder; // Neues Feld: Wer hat zuletzt geworfen
+    float throwCooldown;    // Neues Feld: Cooldown-Timer
 
 public:
+    static const std::int8_t NO_HOLDER = -1;
+
     Weapon(float x, float y);
 
-    void update(float dt);
-    void draw(sf::RenderWindow& window);
-    void throwTo(Player* from, Player* to);
-    bool checkPickup(Player& player);
+    void update(float dt, const Player& player1, const Player& player2);
+    void throwTo(Player& from, int fromIndex, const Player& to);
+    bool checkPickup(Player& player, int playerIndex);
 
-    Player* getHolder() const { return holder; }
+    int getHolder() const { return holder; }
+    bool hasHolder() const { return holder != NO_HOLDER; }
+    sf::Vector2f getPosition() const { return position; }
+    sf::Vector2f getPreviousPosition() const { return previousPosition; }
+    float getRotation() const { return rotation; }
+    float getPreviousRotation() const { return previousRotation; }
 };
\ No newline at end of file
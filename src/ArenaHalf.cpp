@@ -0,0 +1,298 @@
+#include "../include/ArenaHalf.h"
+#include "../include/Constants.h"
+#include "../include/Vector2Utils.h"
+#include <algorithm>
+
+using namespace Constants;
+using namespace Utils;
+
+// Kein Gegner getroffen
+static const std::uint32_t NO_HIT = 0xFFFFFFFFu;
+
+/// <summary>
+/// Constructs an empty arena half whose collision grid covers only this half of the window. The enemy and bullet pools and all per-step buffers are allocated here, so that stepping does not allocate.
+/// </summary>
+/// <param name="leftSide">true for the left half, false for the right half.</param>
+ArenaHalf::ArenaHalf(bool leftSide)
+    : leftSide(leftSide),
+    enemyGrid(leftSide ? 0.0f : WINDOW_WIDTH / 2.0f, 0.0f, WINDOW_WIDTH / 2.0f, static_cast<float>(WINDOW_HEIGHT), GRID_CELL_SIZE),
+    flowField(leftSide ? 0.0f : WINDOW_WIDTH / 2.0f, 0.0f, WINDOW_WIDTH / 2.0f, static_cast<float>(WINDOW_HEIGHT), FLOW_CELL_SIZE),
+    enemies(0),
+    bullets(leftSide, BULLET_POOL_SIZE) {
+    reserveEnemies(ENEMY_POOL_SIZE);
+    bulletHit.reserve(BULLET_POOL_SIZE);
+    bulletRemove.reserve(BULLET_POOL_SIZE);
+}
+
+/// <summary>
+/// Raises the maximum number of enemies in this half, together with the per-step buffers that grow with it. Meant for setup; a smaller value has no effect.
+/// </summary>
+/// <param name="capacity">The new maximum number of enemies.</param>
+void ArenaHalf::reserveEnemies(std::size_t capacity) {
+    enemies.reserve(capacity);
+    enemyGrid.reserve(capacity);
+    enemyHit.reserve(capacity);
+    pushX.reserve(capacity);
+    pushY.reserve(capacity);
+    contacts.reserve((capacity + 63) / 64);
+}
+
+/// <summary>
+/// Adds an obstacle that the enemies of this half path around. Obstacles only steer the enemies; they do not block players or bullets.
+/// </summary>
+/// <param name="left">The x-coordinate of the left edge of the obstacle.</param>
+/// <param name="top">The y-coordinate of the top edge of the obstacle.</param>
+/// <param name="width">The width of the obstacle.</param>
+/// <param name="height">The height of the obstacle.</param>
+void ArenaHalf::addObstacle(float left, float top, float width, float height) {
+    flowField.block(left, top, width, height);
+}
+
+/// <summary>
+/// Returns the x-coordinate of the left edge of this half.
+/// </summary>
+/// <returns>0 for the left half, the middle of the window for the right half.</returns>
+float ArenaHalf::getLeft() const {
+    return leftSide ? 0.0f : WINDOW_WIDTH / 2.0f;
+}
+
+/// <summary>
+/// Returns the x-coordinate of the right edge of this half.
+/// </summary>
+/// <returns>The middle of the window for the left half, the window width for the right half.</returns>
+float ArenaHalf::getRight() const {
+    return leftSide ? WINDOW_WIDTH / 2.0f : static_cast<float>(WINDOW_WIDTH);
+}
+
+/// <summary>
+/// Pushes overlapping enemies apart. Every enemy looks up its neighbours in the grid and moves away from each overlapping one by its share of the overlap. In overcrowded spots, where comparing every pair would make the pass quadratic, an enemy instead moves away from the mean position of its neighbours, which the grid provides per cell in O(1); this keeps the pass O(n) however tightly the crowd packs. All pushes are computed from the positions before the pass, so the result depends neither on the enemy order nor on how the pass is split across threads. The push per step is limited, so that dense crowds spread out over several steps instead of exploding. The push is added to the velocity of the step, so that the swept bullet test sees the real movement.
+/// </summary>
+/// <param name="dt">The simulated time for this step, in seconds.</param>
+/// <param name="jobs">The job system that runs the pass in parallel blocks.</param>
+void ArenaHalf::separateEnemies(float dt, JobSystem& jobs) {
+    const std::size_t count = enemies.size();
+    if (count < 2) {
+        return;
+    }
+
+    const float minDistance = 2.0f * ENEMY_RADIUS;
+    const float minDistanceSq = minDistance * minDistance;
+    enemyGrid.build(enemies.x, enemies.y);
+    pushX.resize(count);
+    pushY.resize(count);
+
+    // Verschiebungen aus den alten Positionen berechnen
+    jobs.parallelFor(count, PARALLEL_ENEMY_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            const float x = enemies.x[i], y = enemies.y[i];
+            float sumX, sumY;
+
+            // Überfüllt: vom Schwerpunkt der Nachbarn (ohne sich selbst) weg
+            std::uint32_t neighbours = enemyGrid.sumAround(x, y, minDistance, sumX, sumY) - 1;
+            if (neighbours > SEPARATION_MAX_NEIGHBOURS) {
+                float inverseCount = 1.0f / neighbours;
+                pushX[i] = (x - (sumX - x) * inverseCount) * SEPARATION_STRENGTH;
+                pushY[i] = (y - (sumY - y) * inverseCount) * SEPARATION_STRENGTH;
+                continue;
+            }
+
+            sumX = 0.0f;
+            sumY = 0.0f;
+            enemyGrid.query(x, y, minDistance, [&](std::uint32_t j) {
+                float dx = x - enemies.x[j];
+                float dy = y - enemies.y[j];
+                float distanceSq = dx * dx + dy * dy;
+                if (distanceSq >= minDistanceSq || j == i) {
+                    return;
+                }
+                if (distanceSq > 0.0f) {
+                    float inverse = rsqrt(distanceSq);
+                    float overlap = minDistance - distanceSq * inverse;
+                    sumX += dx * inverse * overlap;
+                    sumY += dy * inverse * overlap;
+                }
+                else {
+                    // Deckungsgleich: nach Index auseinanderschieben
+                    sumX += j < i ? minDistance : -minDistance;
+                }
+            });
+            pushX[i] = sumX * (SEPARATION_STRENGTH * 0.5f);
+            pushY[i] = sumY * (SEPARATION_STRENGTH * 0.5f);
+        }
+    });
+
+    // Erst danach verschieben
+    const float inverseDt = 1.0f / dt;
+    const float left = getLeft(), right = getRight();
+    jobs.parallelFor(count, PARALLEL_ENEMY_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            float lengthSq = pushX[i] * pushX[i] + pushY[i] * pushY[i];
+            if (lengthSq == 0.0f) {
+                continue;
+            }
+            float scale = lengthSq > SEPARATION_MAX_PUSH * SEPARATION_MAX_PUSH ? SEPARATION_MAX_PUSH * rsqrt(lengthSq) : 1.0f;
+            // Gegner bleiben in ihrer Hälfte und im Fenster
+            float newX = std::min(std::max(enemies.x[i] + pushX[i] * scale, left), right);
+            float newY = std::min(std::max(enemies.y[i] + pushY[i] * scale, 0.0f), static_cast<float>(WINDOW_HEIGHT));
+            enemies.vx[i] += (newX - enemies.x[i]) * inverseDt;
+            enemies.vy[i] += (newY - enemies.y[i]) * inverseDt;
+            enemies.x[i] = newX;
+            enemies.y[i] = newY;
+        }
+    });
+}
+
+/// <summary>
+/// Finds the enemy that a bullet hits first along its path in this step, only looking at the grid cells around the path and skipping enemies already marked as hit. Only the part of the path before the stop line counts. If several enemies are touched at the same time, the one with the lowest index wins.
+/// </summary>
+/// <param name="bullet">The index of the bullet.</param>
+/// <param name="dt">The simulated time for this step, in seconds.</param>
+/// <param name="reach">The query radius around the middle of the path.</param>
+/// <returns>The index of the enemy hit, or NO_HIT.</returns>
+std::uint32_t ArenaHalf::findHit(std::size_t bullet, float dt, float reach) const {
+    float stop = bullets.middleFraction(bullet, dt);
+    if (stop == 0.0f) {
+        return NO_HIT;
+    }
+
+    float limit = stop > 0.0f ? stop : 1.0f;
+    float halfX = bullets.vx[bullet] * dt * 0.5f;
+    float halfY = bullets.vy[bullet] * dt * 0.5f;
+
+    std::uint32_t hit = NO_HIT;
+    float hitTime = limit;
+    enemyGrid.query(bullets.x[bullet] - halfX, bullets.y[bullet] - halfY, reach, [&](std::uint32_t j) {
+        if (enemyHit[j]) {
+            return;
+        }
+        float t = bullets.sweepHit(bullet, dt, enemies, j);
+        if (t >= 0.0f && (t < hitTime || (t == hitTime && j < hit))) {
+            hit = j;
+            hitTime = t;
+        }
+    });
+    return hit;
+}
+
+/// <summary>
+/// Advances the enemies and bullets of this half by one step: moves the enemies toward the player along the flow field and pushes overlapping ones apart, removes enemies that touch the player, moves the bullets and resolves bullet hits against the enemies of this half only. The data-parallel passes run in blocks on the job system; removals are collected per enemy and per bullet and applied afterwards in a fixed order, so the result does not depend on the number of threads.
+/// </summary>
+/// <param name="dt">The simulated time for this step, in seconds.</param>
+/// <param name="player">The player standing in this half.</param>
+/// <param name="jobs">The job system that runs the data-parallel passes.</param>
+/// <returns>The number of enemies that touched the player in this step.</returns>
+int ArenaHalf::update(float dt, const Player& player, JobSystem& jobs) {
+    int touching = 0;
+
+    // Flussfeld nachführen (nur bei Zellwechsel des Spielers) und Gegner updaten
+    flowField.update(player.getPosition());
+    jobs.parallelFor(enemies.size(), PARALLEL_ENEMY_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+        enemies.update(dt, player, flowField, begin, end);
+    });
+    separateEnemies(dt, jobs);
+
+    // Kollisionen mit dem Spieler für alle Gegner auf einmal prüfen, jeder
+    // Block in seine eigenen Wörter der Bitmaske. Die Treffer von hinten
+    // entfernen: der nachrückende letzte Gegner wurde dann schon geprüft.
+    // Leere Wörter der Bitmaske werden übersprungen.
+    contacts.resize((enemies.size() + 63) / 64);
+    jobs.parallelFor(enemies.size(), PARALLEL_ENEMY_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+        enemies.checkCollisions(player, contacts, begin, end);
+    });
+    for (std::size_t word = contacts.size(); word-- > 0;) {
+        std::uint64_t bits = contacts[word];
+        for (int bit = 63; bits != 0; bit--) {
+            if (bits & (std::uint64_t(1) << bit)) {
+                bits &= ~(std::uint64_t(1) << bit);
+                enemies.remove(word * 64 + bit);
+                touching++;
+            }
+        }
+    }
+
+    // Kugeln updaten
+    jobs.parallelFor(bullets.size(), PARALLEL_BULLET_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+        bullets.update(dt, begin, end);
+    });
+
+    // Gegner-Gitter für die Trefferabfrage aufbauen. Getroffene Gegner werden
+    // erst am Ende entfernt, damit die Indizes im Gitter gültig bleiben.
+    if (bullets.size() > 0) {
+        enemyGrid.build(enemies.x, enemies.y);
+    }
+    enemyHit.assign(enemies.size(), 0);
+
+    // Abfrage-Reichweite um die Mitte der Flugstrecke: halbe Strecke einer
+    // Kugel plus Strecke eines Gegners pro Schritt (Verfolgung und Separation)
+    // plus beide Radien. Alle Kugeln fliegen mit BULLET_SPEED, das spart die
+    // Wurzel pro Kugel.
+    const float reach = BULLET_SPEED * dt * 0.5f + ENEMY_SPEED * dt + SEPARATION_MAX_PUSH + BULLET_RADIUS + ENEMY_RADIUS;
+
+    // Ersten Treffer jeder Kugel parallel suchen, noch ohne gegenseitige Konflikte
+    bulletHit.resize(bullets.size());
+    jobs.parallelFor(bullets.size(), PARALLEL_BULLET_GRAIN, [&](std::size_t begin, std::size_t end, std::size_t) {
+        for (std::size_t i = begin; i < end; i++) {
+            bulletHit[i] = findHit(i, dt, reach);
+        }
+    });
+
+    // In Kugelreihenfolge zusammenführen: ist der Gegner schon von einer
+    // früheren Kugel getroffen, wird für diese Kugel neu gesucht. Eine Kugel
+    // endet bei einem Treffer, an der Mittellinie oder außerhalb des Fensters.
+    bulletRemove.resize(bullets.size());
+    for (std::size_t i = 0; i < bullets.size(); i++) {
+        std::uint32_t hit = bulletHit[i];
+        if (hit != NO_HIT && enemyHit[hit]) {
+            hit = findHit(i, dt, reach);
+        }
+        if (hit != NO_HIT) {
+            enemyHit[hit] = 1;
+        }
+        bulletRemove[i] = hit != NO_HIT || bullets.middleFraction(i, dt) >= 0.0f || bullets.isOutOfBounds(i);
+    }
+
+    // Kugeln und getroffene Gegner von hinten entfernen: das nachrückende
+    // letzte Element wurde dann schon geprüft
+    for (std::size_t i = bullets.size(); i-- > 0;) {
+        if (bulletRemove[i]) {
+            bullets.remove(i);
+        }
+    }
+    for (std::size_t j = enemies.size(); j-- > 0;) {
+        if (enemyHit[j]) {
+            enemies.remove(j);
+        }
+    }
+
+    return touching;
+}
+
+/// <summary>
+/// Removes all enemies and bullets of this half.
+/// </summary>
+void ArenaHalf::clear() {
+    enemies.clear();
+    bullets.clear();
+}
+
+/// <summary>
+/// Writes the enemies and bullets of this half. The grid, the flow field and the per-step buffers are derived from them in every step and are not part of the state.
+/// </summary>
+/// <param name="state">The state to append to.</param>
+void ArenaHalf::saveState(SimulationState& state) const {
+    enemies.saveState(state);
+    bullets.saveState(state);
+}
+
+/// <summary>
+/// Restores the enemies and bullets written by saveState and makes room in the per-step buffers for the restored enemy pool.
+/// </summary>
+/// <param name="in">The reader positioned at the saved half.</param>
+/// <returns>true if the state was read completely; otherwise, false.</returns>
+bool ArenaHalf::loadState(StateReader& in) {
+    if (!enemies.loadState(in) || !bullets.loadState(in)) {
+        return false;
+    }
+    reserveEnemies(enemies.getCapacity());
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,701 @@
+#include "../include/Benchmark.h"
+#include "../include/Simulation.h"
+#include "../include/SimdKernels.h"
+#include "../include/Constants.h"
+#include "../include/Vector2Utils.h"
+#include "../include/FlowField.h"
+#include "../include/ArenaHalf.h"
+#include "../include/InputCollector.h"
+#include "../include/LatencyStats.h"
+#include "../include/RenderSnapshot.h"
+#include "../include/SimulationState.h"
+#include "../include/Replay.h"
+#include <SFML/System/Sleep.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+
+// Schritte pro Messung
+static const int BENCH_TICKS = 300;
+
+// Gemessene Hordengrößen
+static const std::size_t HORDE_SIZES[] = { 1000, 10000, 100000 };
+
+// Messdauer der Latenzmessung in Sekunden Echtzeit
+static const float LATENCY_BENCH_SECONDS = 5.0f;
+
+/// <summary>
+/// Advances the simulation by one step and returns how long the step took. Generating the input is not part of the measurement.
+/// </summary>
+/// <param name="simulation">The simulation to advance.</param>
+/// <param name="dt">The duration of the step, in seconds.</param>
+/// <param name="input">The input for the step.</param>
+/// <returns>The wall time of the step, in milliseconds.</returns>
+static double timedStep(Simulation& simulation, float dt, const TickInput& input) {
+    auto start = std::chrono::steady_clock::now();
+    simulation.step(dt, input);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/// <summary>
+/// Measures the cost of a simulation step with large hordes (1k, 10k and 100k enemies) while players are invulnerable, so that enemies are removed continuously on contact and by bullets.
+/// </summary>
+/// <param name="options">Seed and simulated tick rate.</param>
+/// <returns>The process exit code.</returns>
+static int benchRemoval(const HeadlessOptions& options) {
+    float dt = 1.0f / options.tickRate;
+
+    std::printf("%10s %12s %14s\n", "Gegner", "ms/Tick", "entfernt/Tick");
+    for (std::size_t hordeSize : HORDE_SIZES) {
+        Simulation simulation(options.seed, false, options.threads);
+        simulation.setInvulnerable(true);
+        simulation.spawnHorde(hordeSize);
+
+        std::size_t spawned = hordeSize;
+        double totalMs = 0.0;
+        for (int i = 0; i < BENCH_TICKS; i++) {
+            std::size_t before = simulation.getEnemyCount();
+            totalMs += timedStep(simulation, dt, autopilotInput(simulation, options.tickRate));
+            // Nachgespawnte Gegner mitzählen
+            if (simulation.getEnemyCount() > before) {
+                spawned += simulation.getEnemyCount() - before;
+            }
+        }
+
+        double ms = totalMs / BENCH_TICKS;
+        double removed = static_cast<double>(spawned - simulation.getEnemyCount()) / BENCH_TICKS;
+        std::printf("%10zu %12.4f %14.1f\n", hordeSize, ms, removed);
+    }
+    return 0;
+}
+
+/// <summary>
+/// Measures the bullet-vs-enemy hit test like an automatic weapon: the weapon holder fires every step while sweeping its aim, against hordes of 1k, 10k and 100k enemies.
+/// </summary>
+/// <param name="options">Seed and simulated tick rate.</param>
+/// <returns>The process exit code.</returns>
+static int benchCollision(const HeadlessOptions& options) {
+    float dt = 1.0f / options.tickRate;
+
+    std::printf("%10s %12s %12s %10s\n", "Gegner", "ms/Tick", "Kugeln/Tick", "Treffer");
+    for (std::size_t hordeSize : HORDE_SIZES) {
+        Simulation simulation(options.seed, false, options.threads);
+        simulation.setInvulnerable(true);
+
+        // Erst einen Spieler die Waffe aufheben lassen
+        while (!simulation.getWeapon().hasHolder()) {
+            simulation.step(dt, autopilotInput(simulation, options.tickRate));
+        }
+        simulation.spawnHorde(hordeSize);
+
+        double totalMs = 0.0;
+        std::size_t bulletTicks = 0;
+        std::size_t hits = 0;
+        for (int i = 0; i < BENCH_TICKS; i++) {
+            // Dauerfeuer mit schwenkendem Zielen
+            TickInput input;
+            sf::Vector2f aim(std::cos(i * 0.05f), std::sin(i * 0.05f));
+            input.player1.aim = aim;
+            input.player1.shoot = true;
+            input.player2.aim = aim;
+            input.player2.shoot = true;
+
+            std::size_t enemiesBefore = simulation.getEnemyCount();
+            totalMs += timedStep(simulation, dt, input);
+            bulletTicks += simulation.getBulletCount();
+            hits += enemiesBefore - std::min(enemiesBefore, simulation.getEnemyCount());
+        }
+
+        std::printf("%10zu %12.4f %12.1f %10zu\n", hordeSize, totalMs / BENCH_TICKS,
+            static_cast<double>(bulletTicks) / BENCH_TICKS, hits);
+    }
+    return 0;
+}
+
+// Eingaben und Ergebnisse der SIMD-Kernel
+struct KernelData {
+    std::vector<float> x, y, vx, vy;
+    std::vector<std::uint8_t> status;
+    std::vector<std::uint64_t> contacts;
+};
+
+/// <summary>
+/// Creates random positions across and slightly beyond the window and random velocities at bullet speed. Some entities sit exactly on the target to cover the zero-length case.
+/// </summary>
+/// <param name="count">The number of entities.</param>
+/// <param name="seed">Seed for the random number generator.</param>
+/// <param name="target">The seek target; every 97th entity is placed on it.</param>
+/// <returns>The generated data.</returns>
+static KernelData randomKernelData(std::size_t count, unsigned int seed, const sf::Vector2f& target) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> posX(-20.0f, Constants::WINDOW_WIDTH + 20.0f);
+    std::uniform_real_distribution<float> posY(-20.0f, Constants::WINDOW_HEIGHT + 20.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 2.0f * Utils::PI);
+
+    KernelData data;
+    for (std::size_t i = 0; i < count; i++) {
+        float a = angle(rng);
+        bool onTarget = i % 97 == 0;
+        data.x.push_back(onTarget ? target.x : posX(rng));
+        data.y.push_back(onTarget ? target.y : posY(rng));
+        data.vx.push_back(std::cos(a) * Constants::BULLET_SPEED);
+        data.vy.push_back(std::sin(a) * Constants::BULLET_SPEED);
+    }
+    data.status.assign(count, 0);
+    data.contacts.assign((count + 63) / 64, 0);
+    return data;
+}
+
+/// <summary>
+/// Returns the distance between two floats in units in the last place; 0 means bitwise equal.
+/// </summary>
+/// <param name="a">The first value.</param>
+/// <param name="b">The second value.</param>
+/// <returns>The number of representable floats between a and b.</returns>
+static std::uint32_t ulpDistance(float a, float b) {
+    std::int32_t ia, ib;
+    std::memcpy(&ia, &a, sizeof(float));
+    std::memcpy(&ib, &b, sizeof(float));
+    // Vorzeichen-Betrag in eine monotone Ganzzahl-Ordnung umrechnen
+    if (ia < 0) ia = INT32_MIN - ia;
+    if (ib < 0) ib = INT32_MIN - ib;
+    std::int64_t d = static_cast<std::int64_t>(ia) - ib;
+    return static_cast<std::uint32_t>(d < 0 ? -d : d);
+}
+
+/// <summary>
+/// Compares the results of two kernel runs.
+/// </summary>
+/// <param name="a">The reference result.</param>
+/// <param name="b">The result to check.</param>
+/// <param name="flagMismatches">Receives the number of status bytes and contact mask words that differ.</param>
+/// <returns>The largest difference of any coordinate or velocity, in units in the last place.</returns>
+static std::uint32_t compareKernelData(const KernelData& a, const KernelData& b, std::size_t& flagMismatches) {
+    std::uint32_t maxUlps = 0;
+    flagMismatches = 0;
+    for (std::size_t i = 0; i < a.x.size(); i++) {
+        maxUlps = std::max({ maxUlps, ulpDistance(a.x[i], b.x[i]), ulpDistance(a.y[i], b.y[i]),
+            ulpDistance(a.vx[i], b.vx[i]), ulpDistance(a.vy[i], b.vy[i]) });
+        if (a.status[i] != b.status[i]) {
+            flagMismatches++;
+        }
+    }
+    for (std::size_t w = 0; w < a.contacts.size(); w++) {
+        if (a.contacts[w] != b.contacts[w]) {
+            flagMismatches++;
+        }
+    }
+    return maxUlps;
+}
+
+/// <summary>
+/// Measures the enemy seek kernel, the bullet kernel and the contact kernel at every instruction set level the CPU supports against the scalar path, and checks that all levels agree with the scalar results bit for bit after BENCH_TICKS steps.
+/// </summary>
+/// <param name="options">Seed and simulated tick rate.</param>
+/// <returns>The process exit code; 1 if any level disagrees with the scalar path.</returns>
+static int benchKernels(const HeadlessOptions& options) {
+    const float dt = 1.0f / options.tickRate;
+    const sf::Vector2f target(Constants::WINDOW_WIDTH / 4.0f, Constants::WINDOW_HEIGHT / 2.0f);
+    const float stopX = Constants::WINDOW_WIDTH / 2.0f - 5.0f;
+    const Simd::Level detected = Simd::detectLevel();
+    bool agree = true;
+
+    std::printf("Erkannt: %s\n", Simd::getLevelName(detected));
+    std::printf("%10s %8s %12s %12s %12s %8s %8s\n", "Anzahl", "Stufe", "Gegner ms", "Kugeln ms", "Kontakt ms", "Faktor", "ULP");
+    for (std::size_t count : HORDE_SIZES) {
+        const KernelData initial = randomKernelData(count, options.seed, target);
+        KernelData reference;
+        double scalarMs = 0.0;
+
+        for (int level = 0; level <= static_cast<int>(detected); level++) {
+            Simd::setLevel(static_cast<Simd::Level>(level));
+
+            // Gegner, Kugeln und Kontakte getrennt, jeweils vom selben Anfangszustand
+            KernelData enemies = initial;
+            KernelData bullets = initial;
+            KernelData touching = initial;
+            auto start = std::chrono::steady_clock::now();
+            for (int i = 0; i < BENCH_TICKS; i++) {
+                Simd::seek(enemies.x.data(), enemies.y.data(), enemies.vx.data(), enemies.vy.data(), count,
+                    target.x, target.y, Constants::ENEMY_SPEED, dt);
+            }
+            auto middle = std::chrono::steady_clock::now();
+            for (int i = 0; i < BENCH_TICKS; i++) {
+                Simd::advanceBullets(bullets.x.data(), bullets.y.data(), bullets.vx.data(), bullets.vy.data(),
+                    bullets.status.data(), count, dt, static_cast<float>(Constants::WINDOW_WIDTH),
+                    static_cast<float>(Constants::WINDOW_HEIGHT), stopX, true);
+            }
+            auto beforeContacts = std::chrono::steady_clock::now();
+            for (int i = 0; i < BENCH_TICKS; i++) {
+                Simd::overlapMask(touching.x.data(), touching.y.data(), count, target.x, target.y,
+                    Constants::PLAYER_RADIUS + Constants::ENEMY_RADIUS, touching.contacts.data());
+            }
+            auto end = std::chrono::steady_clock::now();
+
+            double enemyMs = std::chrono::duration<double, std::milli>(middle - start).count() / BENCH_TICKS;
+            double bulletMs = std::chrono::duration<double, std::milli>(beforeContacts - middle).count() / BENCH_TICKS;
+            double contactMs = std::chrono::duration<double, std::milli>(end - beforeContacts).count() / BENCH_TICKS;
+            double totalMs = enemyMs + bulletMs + contactMs;
+
+            // Ergebnis: Gegnerzustand, dazu Positionen und Status der Kugeln und die Kontakte
+            KernelData result = enemies;
+            result.contacts = touching.contacts;
+            result.x.insert(result.x.end(), bullets.x.begin(), bullets.x.end());
+            result.y.insert(result.y.end(), bullets.y.begin(), bullets.y.end());
+            result.vx.insert(result.vx.end(), bullets.vx.begin(), bullets.vx.end());
+            result.vy.insert(result.vy.end(), bullets.vy.begin(), bullets.vy.end());
+            result.status = bullets.status;
+            result.status.insert(result.status.begin(), count, 0);
+
+            std::uint32_t ulps = 0;
+            if (level == 0) {
+                reference = result;
+                scalarMs = totalMs;
+            }
+            else {
+                std::size_t flagMismatches = 0;
+                ulps = compareKernelData(reference, result, flagMismatches);
+                if (ulps > 0 || flagMismatches > 0) {
+                    agree = false;
+                }
+            }
+
+            std::printf("%10zu %8s %12.4f %12.4f %12.4f %8.2f %8u\n", count, Simd::getLevelName(static_cast<Simd::Level>(level)),
+                enemyMs, bulletMs, contactMs, scalarMs / totalMs, ulps);
+        }
+    }
+    Simd::setLevel(detected);
+
+    std::printf(agree ? "Alle Stufen stimmen bitgenau mit dem Skalarpfad überein\n" : "FEHLER: Abweichung vom Skalarpfad\n");
+    return agree ? 0 : 1;
+}
+
+// Eingaben pro Geschwindigkeitsmessung der Mathe-Näherungen
+static const std::size_t MATH_SAMPLES = 1 << 20;
+
+/// <summary>
+/// Measures how long a function takes per call over an array of inputs. The results are summed up so that the compiler cannot drop the calls.
+/// </summary>
+/// <param name="inputs">The inputs to call the function with.</param>
+/// <param name="function">The function to measure; takes one input and returns a float.</param>
+/// <returns>The average time per call, in nanoseconds.</returns>
+template <typename Input, typename Function>
+static double nanosecondsPerCall(const std::vector<Input>& inputs, Function function) {
+    static volatile float sink = 0.0f;
+    float sum = 0.0f;
+    auto start = std::chrono::steady_clock::now();
+    for (const Input& input : inputs) {
+        sum += function(input);
+    }
+    auto end = std::chrono::steady_clock::now();
+    sink = sink + sum;
+    return std::chrono::duration<double, std::nano>(end - start).count() / inputs.size();
+}
+
+/// <summary>
+/// Checks the fast approximations in Utils against the standard library over dense samples of their documented input ranges, and measures both against each other. The batched Simd::normalize is checked against the error bound of fastNormalize and timed per vector.
+/// </summary>
+/// <param name="options">Seed for the random inputs of the speed measurement.</param>
+/// <returns>The process exit code; 1 if an approximation exceeds its documented error bound.</returns>
+static int benchMath(const HeadlessOptions& options) {
+    // Genauigkeit: größter Fehler über dichte Stichproben, in double gerechnet
+    double rsqrtError = 0.0;
+    for (float x = 1e-30f; x < 1e30f; x *= 1.0001f) {
+        rsqrtError = std::max(rsqrtError, std::fabs(Utils::rsqrt(x) * std::sqrt(static_cast<double>(x)) - 1.0));
+    }
+
+    double sinCosError = 0.0;
+    for (int i = -1000000; i <= 1000000; i++) {
+        float radians = i * (2.0f * Utils::PI / 1000000);
+        float sine, cosine;
+        Utils::sinCos(radians, sine, cosine);
+        sinCosError = std::max({ sinCosError, std::fabs(sine - std::sin(static_cast<double>(radians))),
+            std::fabs(cosine - std::cos(static_cast<double>(radians))) });
+    }
+
+    double atan2Error = 0.0;
+    for (int i = 0; i < 1000000; i++) {
+        double angle = i * (2.0 * 3.14159265358979 / 1000000);
+        for (float radius : { 1e-3f, 1.0f, 1000.0f }) {
+            float y = static_cast<float>(radius * std::sin(angle));
+            float x = static_cast<float>(radius * std::cos(angle));
+            double error = std::fabs(Utils::fastAtan2(y, x) - std::atan2(static_cast<double>(y), static_cast<double>(x)));
+            // -PI und PI sind derselbe Winkel
+            atan2Error = std::max(atan2Error, std::min(error, std::fabs(error - 2.0 * 3.14159265358979)));
+        }
+    }
+
+    // Sonderfälle: Nullvektor und Ursprung
+    bool specialCases = Utils::fastNormalize(sf::Vector2f(0, 0)) == sf::Vector2f(0, 0) && Utils::fastAtan2(0, 0) == 0.0f;
+
+    // Geschwindigkeit: zufällige Eingaben aus dem Bereich, der im Spiel vorkommt
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<float> coordinate(-1000.0f, 1000.0f);
+    std::uniform_real_distribution<float> angle(-Utils::PI, Utils::PI);
+    std::vector<sf::Vector2f> vectors(MATH_SAMPLES);
+    std::vector<float> angles(MATH_SAMPLES);
+    for (std::size_t i = 0; i < MATH_SAMPLES; i++) {
+        vectors[i] = sf::Vector2f(coordinate(rng), coordinate(rng));
+        angles[i] = angle(rng);
+    }
+
+    const sf::Vector2f origin(0, 0);
+    const float radius = 500.0f;
+    double distanceStd = nanosecondsPerCall(vectors, [&](const sf::Vector2f& v) { return Utils::distance(v, origin) < radius ? 1.0f : 0.0f; });
+    double distanceFast = nanosecondsPerCall(vectors, [&](const sf::Vector2f& v) { return Utils::isWithin(v, origin, radius) ? 1.0f : 0.0f; });
+    double normalizeStd = nanosecondsPerCall(vectors, [](const sf::Vector2f& v) { return Utils::normalize(v).x; });
+    double normalizeFast = nanosecondsPerCall(vectors, [](const sf::Vector2f& v) { return Utils::fastNormalize(v).x; });
+
+    // Gebündelt über flache Arrays, mit der Fehlergrenze von fastNormalize
+    std::vector<float> normalizeX(MATH_SAMPLES), normalizeY(MATH_SAMPLES);
+    for (std::size_t i = 0; i < MATH_SAMPLES; i++) {
+        normalizeX[i] = vectors[i].x;
+        normalizeY[i] = vectors[i].y;
+    }
+    auto batchStart = std::chrono::steady_clock::now();
+    Simd::normalize(normalizeX.data(), normalizeY.data(), MATH_SAMPLES);
+    double normalizeBatch = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - batchStart).count() / MATH_SAMPLES;
+    double batchError = 0.0;
+    for (std::size_t i = 0; i < MATH_SAMPLES; i++) {
+        double length = std::sqrt(static_cast<double>(vectors[i].x) * vectors[i].x + static_cast<double>(vectors[i].y) * vectors[i].y);
+        batchError = std::max(batchError, std::fabs(normalizeX[i] - vectors[i].x / length));
+        batchError = std::max(batchError, std::fabs(normalizeY[i] - vectors[i].y / length));
+    }
+    double sinCosStd = nanosecondsPerCall(angles, [](float a) { return std::sin(a) + std::cos(a); });
+    double sinCosFast = nanosecondsPerCall(angles, [](float a) { float s, c; Utils::sinCos(a, s, c); return s + c; });
+    double atan2Std = nanosecondsPerCall(vectors, [](const sf::Vector2f& v) { return std::atan2(v.y, v.x); });
+    double atan2Fast = nanosecondsPerCall(vectors, [](const sf::Vector2f& v) { return Utils::fastAtan2(v.y, v.x); });
+
+    std::printf("%-14s %12s %12s %10s %10s\n", "Funktion", "max. Fehler", "Grenze", "std ns", "schnell ns");
+    std::printf("%-14s %12s %12s %10.2f %10.2f\n", "isWithin", "exakt", "-", distanceStd, distanceFast);
+    std::printf("%-14s %12.3g %12.3g %10.2f %10.2f\n", "fastNormalize", rsqrtError, Utils::RSQRT_MAX_REL_ERROR, normalizeStd, normalizeFast);
+    std::printf("%-14s %12.3g %12.3g %10.2f %10.2f\n", "normalize[]", batchError, Utils::RSQRT_MAX_REL_ERROR, normalizeStd, normalizeBatch);
+    std::printf("%-14s %12.3g %12.3g %10.2f %10.2f\n", "sinCos", sinCosError, Utils::SINCOS_MAX_ERROR, sinCosStd, sinCosFast);
+    std::printf("%-14s %12.3g %12.3g %10.2f %10.2f\n", "fastAtan2", atan2Error, Utils::ATAN2_MAX_ERROR, atan2Std, atan2Fast);
+
+    bool withinBounds = specialCases && batchError <= Utils::RSQRT_MAX_REL_ERROR && rsqrtError <= Utils::RSQRT_MAX_REL_ERROR &&
+        sinCosError <= Utils::SINCOS_MAX_ERROR && atan2Error <= Utils::ATAN2_MAX_ERROR;
+    std::printf(withinBounds ? "Alle Näherungen innerhalb ihrer Fehlergrenzen\n" : "FEHLER: Fehlergrenze überschritten\n");
+    return withinBounds ? 0 : 1;
+}
+
+/// <summary>
+/// Places four pillars in each half of the window, between the enemies and the player.
+/// </summary>
+/// <param name="simulation">The simulation to add the pillars to.</param>
+static void addPillars(Simulation& simulation) {
+    const float width = 40.0f, height = Constants::WINDOW_HEIGHT / 4.0f;
+    for (float x : { 0.1f, 0.35f, 0.65f, 0.9f }) {
+        for (float y : { 0.2f, 0.55f }) {
+            if ((x < 0.5f) == (y < 0.5f)) {
+                simulation.addObstacle(x * Constants::WINDOW_WIDTH - width / 2, y * Constants::WINDOW_HEIGHT, width, height);
+            }
+        }
+    }
+}
+
+/// <summary>
+/// Measures enemy navigation: the cost of recomputing a flow field when its target changes cell, and the cost of a simulation step with hordes of 1k, 10k and 100k enemies without and with obstacles.
+/// </summary>
+/// <param name="options">Seed and simulated tick rate.</param>
+/// <returns>The process exit code.</returns>
+static int benchFlow(const HeadlessOptions& options) {
+    float dt = 1.0f / options.tickRate;
+
+    // Neuberechnung: Ziel springt jedes Mal in eine andere Zelle
+    const float halfWidth = Constants::WINDOW_WIDTH / 2.0f;
+    FlowField field(0.0f, 0.0f, halfWidth, static_cast<float>(Constants::WINDOW_HEIGHT), Constants::FLOW_CELL_SIZE);
+    field.block(halfWidth * 0.5f - 20.0f, Constants::WINDOW_HEIGHT * 0.2f, 40.0f, Constants::WINDOW_HEIGHT * 0.6f);
+    const int rebuilds = 1000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rebuilds; i++) {
+        field.update(sf::Vector2f(halfWidth * (i % 2 == 0 ? 0.25f : 0.75f), Constants::WINDOW_HEIGHT * 0.5f));
+    }
+    auto end = std::chrono::steady_clock::now();
+    std::printf("Flussfeld-Neuberechnung: %.1f us\n\n", std::chrono::duration<double, std::micro>(end - start).count() / rebuilds);
+
+    std::printf("%10s %16s %16s\n", "Gegner", "ohne ms/Tick", "Hindernisse");
+    for (std::size_t hordeSize : HORDE_SIZES) {
+        double ms[2];
+        for (int withObstacles = 0; withObstacles < 2; withObstacles++) {
+            Simulation simulation(options.seed, false, options.threads);
+            simulation.setInvulnerable(true);
+            if (withObstacles) {
+                addPillars(simulation);
+            }
+            simulation.spawnHorde(hordeSize);
+
+            double totalMs = 0.0;
+            for (int i = 0; i < BENCH_TICKS; i++) {
+                totalMs += timedStep(simulation, dt, autopilotInput(simulation, options.tickRate));
+            }
+            ms[withObstacles] = totalMs / BENCH_TICKS;
+        }
+        std::printf("%10zu %16.4f %16.4f\n", hordeSize, ms[0], ms[1]);
+    }
+    return 0;
+}
+
+/// <summary>
+/// Measures the enemy separation pass alone with 1k, 10k and 50k enemies in one half, all chasing a player that stands still, so that the crowd packs around the player. Checks that the crowd stays stable, i.e. no enemy ends up at an invalid position, outside its half or above or below the window.
+/// </summary>
+/// <param name="options">Seed and simulated tick rate.</param>
+/// <returns>The process exit code; 1 if an enemy ended up at an invalid position.</returns>
+static int benchSeparation(const HeadlessOptions& options) {
+    static const std::size_t CROWD_SIZES[] = { 1000, 10000, 50000 };
+    float dt = 1.0f / options.tickRate;
+    const float halfWidth = Constants::WINDOW_WIDTH / 2.0f;
+    bool stable = true;
+
+    std::printf("%10s %12s %14s\n", "Gegner", "ms/Tick", "ms/Tick Ende");
+    for (std::size_t crowdSize : CROWD_SIZES) {
+        std::mt19937 rng(options.seed);
+        std::uniform_real_distribution<float> posX(0.0f, halfWidth);
+        std::uniform_real_distribution<float> posY(0.0f, static_cast<float>(Constants::WINDOW_HEIGHT));
+
+        ArenaHalf half(true);
+        half.reserveEnemies(crowdSize);
+        for (std::size_t i = 0; i < crowdSize; i++) {
+            half.enemies.add(posX(rng), posY(rng));
+        }
+        Player player(halfWidth / 2.0f, Constants::WINDOW_HEIGHT / 2.0f, false, 0);
+        FlowField field(0.0f, 0.0f, halfWidth, static_cast<float>(Constants::WINDOW_HEIGHT), Constants::FLOW_CELL_SIZE);
+        JobSystem jobs(options.threads);
+
+        // Gesamt und letztes Zehntel, wenn sich die Menge um den Spieler verdichtet hat
+        double totalMs = 0.0, lateMs = 0.0;
+        for (int i = 0; i < BENCH_TICKS; i++) {
+            half.enemies.update(dt, player, field, 0, half.enemies.size());
+            auto start = std::chrono::steady_clock::now();
+            half.separateEnemies(dt, jobs);
+            auto end = std::chrono::steady_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(end - start).count();
+            totalMs += ms;
+            if (i >= BENCH_TICKS - BENCH_TICKS / 10) {
+                lateMs += ms;
+            }
+        }
+
+        for (std::size_t i = 0; i < half.enemies.size(); i++) {
+            float x = half.enemies.x[i], y = half.enemies.y[i];
+            if (!std::isfinite(x) || !std::isfinite(y) || x < 0.0f || x > halfWidth ||
+                y < 0.0f || y > Constants::WINDOW_HEIGHT) {
+                stable = false;
+            }
+        }
+        std::printf("%10zu %12.4f %14.4f\n", crowdSize, totalMs / BENCH_TICKS, lateMs / (BENCH_TICKS / 10));
+    }
+
+    std::printf(stable ? "Alle Gegner an gültigen Positionen\n" : "FEHLER: Gegner an ungültiger Position\n");
+    return stable ? 0 : 1;
+}
+
+/// <summary>
+/// Measures saving and restoring the complete game state with hordes of 1k, 10k and 100k enemies, and checks that a restored simulation continues exactly like the original: both run BENCH_TICKS further steps with the same input and must end with the same checksum.
+/// </summary>
+/// <param name="options">Seed and simulated tick rate.</param>
+/// <returns>The process exit code; 1 if a restored simulation diverged.</returns>
+static int benchSnapshot(const HeadlessOptions& options) {
+    static const int REPEATS = 200;
+    float dt = 1.0f / options.tickRate;
+    bool exact = true;
+
+    std::printf("%10s %10s %12s %12s %10s\n", "Gegner", "KiB", "us sichern", "us laden", "Prüfsumme");
+    for (std::size_t hordeSize : HORDE_SIZES) {
+        Simulation simulation(options.seed, false, options.threads);
+        simulation.setInvulnerable(true);
+        simulation.spawnHorde(hordeSize);
+        for (int i = 0; i < BENCH_TICKS / 10; i++) {
+            simulation.step(dt, autopilotInput(simulation, options.tickRate));
+        }
+
+        // Erster Durchlauf legt den Puffer an und zählt nicht
+        SimulationState state;
+        simulation.saveState(state);
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < REPEATS; i++) {
+            simulation.saveState(state);
+        }
+        auto middle = std::chrono::steady_clock::now();
+        for (int i = 0; i < REPEATS; i++) {
+            simulation.loadState(state);
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        // Original weiterlaufen lassen, dann vom Stand aus dasselbe wiederholen
+        std::vector<TickInput> inputs;
+        for (int i = 0; i < BENCH_TICKS; i++) {
+            inputs.push_back(autopilotInput(simulation, options.tickRate));
+            simulation.step(dt, inputs.back());
+        }
+        std::uint64_t expected = stateChecksum(simulation);
+        bool restored = simulation.loadState(state);
+        for (const TickInput& input : inputs) {
+            simulation.step(dt, input);
+        }
+        bool same = restored && stateChecksum(simulation) == expected;
+        exact = exact && same;
+
+        std::printf("%10zu %10.1f %12.2f %12.2f %10s\n", hordeSize, state.size() / 1024.0,
+            std::chrono::duration<double, std::micro>(middle - start).count() / REPEATS,
+            std::chrono::duration<double, std::micro>(end - middle).count() / REPEATS,
+            same ? "gleich" : "ABWEICHEND");
+    }
+    return exact ? 0 : 1;
+}
+
+/// <summary>
+/// Sleeps until the given time with sf::sleep, which raises the Windows timer resolution to 1 ms for the sleep; std::this_thread would wake up to 15.6 ms late there and distort the measured latency.
+/// </summary>
+/// <param name="time">The time to wake up at; in the past, the call returns right away.</param>
+static void sleepUntil(std::chrono::steady_clock::time_point time) {
+    auto wait = time - std::chrono::steady_clock::now();
+    sf::sleep(sf::microseconds(std::chrono::duration_cast<std::chrono::microseconds>(wait).count()));
+}
+
+/// <summary>
+/// Writes synthetic input events the way the event pump does, up to INPUT_SAMPLE_RATE times per second until stopped: the aim point of both players circles continuously, the movement direction changes every quarter second, and the players shoot in turn eight times per second.
+/// </summary>
+/// <param name="queue">The queue that receives the events.</param>
+/// <param name="running">Cleared to stop the producer.</param>
+static void produceSyntheticInput(InputQueue& queue, const std::atomic<bool>& running) {
+    const auto samplePeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(1.0f / Constants::INPUT_SAMPLE_RATE));
+    const sf::Vector2f directions[4] = { { 1, 0 }, { 0, 1 }, { -1, 0 }, { 0, -1 } };
+    const int samplesPerMove = static_cast<int>(Constants::INPUT_SAMPLE_RATE / 4.0f);
+    const int samplesPerShot = static_cast<int>(Constants::INPUT_SAMPLE_RATE / 8.0f);
+
+    auto push = [&](InputEvent::Type type, int player, sf::Vector2f value, std::chrono::steady_clock::time_point time) {
+        InputEvent event;
+        event.type = type;
+        event.player = static_cast<std::uint8_t>(player);
+        event.value = value;
+        event.time = time;
+        queue.push(event);
+    };
+
+    auto nextSample = std::chrono::steady_clock::now();
+    for (int sample = 0; running; sample++) {
+        auto now = std::chrono::steady_clock::now();
+        for (int player = 0; player < 2; player++) {
+            float centerX = Constants::WINDOW_WIDTH * (player == 0 ? 0.25f : 0.75f);
+            float angle = sample * 0.01f + player * Utils::PI;
+            push(InputEvent::Type::AimAt, player, sf::Vector2f(centerX + 100.0f * std::cos(angle),
+                Constants::WINDOW_HEIGHT * 0.5f + 100.0f * std::sin(angle)), now);
+            if (sample % samplesPerMove == 0) {
+                push(InputEvent::Type::Move, player, directions[(sample / samplesPerMove + player) % 4], now);
+            }
+        }
+        if (sample % samplesPerShot == 0) {
+            push(InputEvent::Type::Shoot, (sample / samplesPerShot) % 2, sf::Vector2f(), now);
+        }
+
+        nextSample = std::max(nextSample + samplePeriod, std::chrono::steady_clock::now());
+        sleepUntil(nextSample);
+    }
+}
+
+/// <summary>
+/// Measures the input latency of the game loop without a window: a producer thread writes synthetic input events like the event pump, and the simulation runs in real time at the fixed tick rate, collecting the events at each step and capturing a render snapshot after it, like the game does. Reports the percentiles from the input to the end of the step that applies it and to the finished snapshot; the time the render thread and the display add on top is not part of it. With --horde the steps carry a realistic load; --latency writes the percentiles as CSV.
+/// </summary>
+/// <param name="options">Seed, tick rate, horde size, threads and the CSV file.</param>
+/// <returns>The process exit code; 1 if the CSV file could not be written.</returns>
+static int benchLatency(const HeadlessOptions& options) {
+    float dt = 1.0f / options.tickRate;
+    Simulation simulation(options.seed, false, options.threads);
+    simulation.setInvulnerable(true);
+    simulation.spawnHorde(options.horde);
+
+    InputQueue queue;
+    InputCollector collector(queue, false);
+    RenderSnapshot snapshot;
+    LatencyStats stepLatency, snapshotLatency;
+
+    std::atomic<bool> running(true);
+    std::thread producer(produceSyntheticInput, std::ref(queue), std::cref(running));
+
+    // Feste Schritte in Echtzeit, ohne Aufholen: jeder Schritt ist eine
+    // Schrittdauer nach dem vorigen fällig
+    const auto tickPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(dt));
+    const unsigned long long ticks = static_cast<unsigned long long>(LATENCY_BENCH_SECONDS * options.tickRate);
+    auto tickEnd = std::chrono::steady_clock::now();
+    for (unsigned long long i = 0; i < ticks; i++) {
+        tickEnd = std::max(tickEnd + tickPeriod, std::chrono::steady_clock::now());
+        sleepUntil(tickEnd);
+
+        TickInput input = collector.collect(simulation, dt, tickEnd);
+        simulation.step(dt, input);
+        auto stepDone = std::chrono::steady_clock::now();
+        snapshot.capture(simulation, tickEnd, dt, dt);
+        auto captured = std::chrono::steady_clock::now();
+
+        if (collector.getHasEvents()) {
+            stepLatency.record(stepDone - collector.getOldestEvent());
+            snapshotLatency.record(captured - collector.getOldestEvent());
+        }
+    }
+    running = false;
+    producer.join();
+
+    std::printf("%llu Ticks bei %.0f Ticks/s, %zu Gegner\n", ticks, options.tickRate, simulation.getEnemyCount());
+    stepLatency.print(std::cout, "Eingabe bis Schritt");
+    snapshotLatency.print(std::cout, "Eingabe bis Snapshot");
+
+    if (options.latencyFile) {
+        std::ofstream out(options.latencyFile);
+        LatencyStats::writeCsvHeader(out);
+        stepLatency.writeCsvRow(out, "input_to_step");
+        snapshotLatency.writeCsvRow(out, "input_to_snapshot");
+        if (!out) {
+            std::cout << "Latenz-Export nach " << options.latencyFile << " fehlgeschlagen" << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/// <summary>
+/// Runs the headless benchmark with the given name.
+/// </summary>
+/// <param name="name">The name of the benchmark.</param>
+/// <param name="options">Seed and simulated tick rate.</param>
+/// <returns>The process exit code; 1 if the benchmark is unknown.</returns>
+int runBenchmark(const std::string& name, const HeadlessOptions& options) {
+    if (name == "removal") {
+        return benchRemoval(options);
+    }
+    if (name == "collision") {
+        return benchCollision(options);
+    }
+    if (name == "kernels") {
+        return benchKernels(options);
+    }
+    if (name == "math") {
+        return benchMath(options);
+    }
+    if (name == "flow") {
+        return benchFlow(options);
+    }
+    if (name == "separation") {
+        return benchSeparation(options);
+    }
+    if (name == "latency") {
+        return benchLatency(options);
+    }
+    if (name == "snapshot") {
+        return benchSnapshot(options);
+    }
+
+    std::cout << "Unbekannter Benchmark: " << name << std::endl;
+    std::cout << "Verfügbar: removal, collision, kernels, math, flow, separation, latency, snapshot" << std::endl;
+    return 1;
+}
\ No newline at end of file
@@ -1,74 +1,166 @@
 #include "../include/Bullet.h"
 #include "../include/Vector2Utils.h"
 #include "../include/Constants.h"
+#include "../include/SimdKernels.h"
+#include "../include/SimulationState.h"
 
 using namespace Constants;
 using namespace Utils;
 
 /// <summary>
-/// Constructs a Bullet object at the specified position and direction.
+/// Constructs an empty bullet pool for one half of the arena and allocates room for the given number of bullets up front, so that shooting never allocates.
 /// </summary>
-/// <param name="x">The initial x-coordinate of the bullet.</param>
-/// <param name="y">The initial y-coordinate of the bullet.</param>
+/// <param name="leftSide">true for the left half, false for the right half.</param>
+/// <param name="capacity">The maximum number of bullets in flight.</param>
+BulletStore::BulletStore(bool leftSide, std::size_t capacity) : leftSide(leftSide), capacity(capacity), dropped(0) {
+    x.reserve(capacity);
+    y.reserve(capacity);
+    vx.reserve(capacity);
+    vy.reserve(capacity);
+    status.reserve(capacity);
+}
+
+/// <summary>
+/// Adds a bullet at the specified position that travels in the given direction, unless the pool is full. A full pool drops the new shot and counts it.
+/// </summary>
+/// <param name="posX">The initial x-coordinate of the bullet.</param>
+/// <param name="posY">The initial y-coordinate of the bullet.</param>
 /// <param name="dir">The direction vector in which the bullet will travel.</param>
-Bullet::Bullet(float x, float y, const sf::Vector2f& dir) : position(x, y) {
-    shape.setRadius(BULLET_RADIUS);
-    shape.setFillColor(sf::Color::Black);
-    shape.setOrigin(BULLET_RADIUS, BULLET_RADIUS);
-    shape.setPosition(position);
-    velocity = normalize(dir) * BULLET_SPEED;
-    startedLeft = x < WINDOW_WIDTH / 2.0f;
+/// <returns>true if the bullet was added; false if the pool was full.</returns>
+bool BulletStore::add(float posX, float posY, const sf::Vector2f& dir) {
+    if (size() >= capacity) {
+        dropped++;
+        return false;
+    }
+    sf::Vector2f velocity = fastNormalize(dir) * BULLET_SPEED;
+    x.push_back(posX);
+    y.push_back(posY);
+    vx.push_back(velocity.x);
+    vy.push_back(velocity.y);
+    status.push_back(0);
+    return true;
 }
 
 /// <summary>
-/// Updates the bullet's position based on its velocity and the elapsed time.
+/// Removes the bullet at the specified index in O(1) by moving the last bullet into its slot (swap and pop). The order of bullets is not preserved.
+/// </summary>
+/// <param name="i">The index of the bullet to remove.</param>
+void BulletStore::remove(std::size_t i) {
+    std::size_t last = size() - 1;
+    x[i] = x[last];
+    y[i] = y[last];
+    vx[i] = vx[last];
+    vy[i] = vy[last];
+    status[i] = status[last];
+
+    x.pop_back();
+    y.pop_back();
+    vx.pop_back();
+    vy.pop_back();
+    status.pop_back();
+}
+
+/// <summary>
+/// Removes all bullets. The pool keeps its memory.
+/// </summary>
+void BulletStore::clear() {
+    x.clear();
+    y.clear();
+    vx.clear();
+    vy.clear();
+    status.clear();
+}
+
+/// <summary>
+/// Updates the positions of the bullets in the given range based on their velocity and the elapsed time, and records for each bullet whether it left the window or reached the stop line in front of the middle, using the batched SIMD kernel. Ranges that do not overlap can be updated in parallel.
 /// </summary>
 /// <param name="dt">The elapsed time since the last update, in seconds.</param>
-void Bullet::update(float dt) {
-    position += velocity * dt;
-    shape.setPosition(position);
+/// <param name="begin">The index of the first bullet to update.</param>
+/// <param name="end">The index after the last bullet to update.</param>
+void BulletStore::update(float dt, std::size_t begin, std::size_t end) {
+    Simd::advanceBullets(x.data() + begin, y.data() + begin, vx.data() + begin, vy.data() + begin, status.data() + begin, end - begin, dt,
+        static_cast<float>(WINDOW_WIDTH), static_cast<float>(WINDOW_HEIGHT), getStopX(), leftSide);
 }
 
 /// <summary>
-/// Draws the bullet on the specified render window.
+/// Returns the x-coordinate of the line in front of the middle of the window at which bullets of this half stop.
 /// </summary>
-/// <param name="window">The SFML render window where the bullet will be drawn.</param>
-void Bullet::draw(sf::RenderWindow& window) {
-    window.draw(shape);
+/// <returns>5 pixels before the middle, seen from this half.</returns>
+float BulletStore::getStopX() const {
+    return WINDOW_WIDTH / 2.0f + (leftSide ? -5.0f : 5.0f);
 }
 
 /// <summary>
-/// Checks if the bullet is outside the window boundaries.
+/// Checks if the bullet at the specified index was outside the window boundaries after the last update.
 /// </summary>
+/// <param name="i">The index of the bullet.</param>
 /// <returns>true if the bullet's position is outside the window; otherwise, false.</returns>
-bool Bullet::isOutOfBounds() const {
-    return position.x < 0 || position.x > WINDOW_WIDTH ||
-        position.y < 0 || position.y > WINDOW_HEIGHT;
+bool BulletStore::isOutOfBounds(std::size_t i) const {
+    return (status[i] & Simd::BULLET_OUT_OF_BOUNDS) != 0;
 }
 
 /// <summary>
-/// Determines whether the bullet should stop when it reaches the middle of the window.
+/// Determines when during the last step the bullet at the specified index reached the stop line in front of the middle of the window.
 /// </summary>
-/// <returns>true if the bullet has reached (or passed) the middle of the window based on its starting side; false otherwise.</returns>
-bool Bullet::shouldStopAtMiddle() const {
-    float middleX = WINDOW_WIDTH / 2.0f;
-
-    // Wenn von links gestartet und jetzt rechts von der Mitte
-    if (startedLeft && position.x >= middleX - 5) {
-        return true;
+/// <param name="i">The index of the bullet.</param>
+/// <param name="dt">The duration of the last step, in seconds.</param>
+/// <returns>The fraction of the last step, between 0 and 1, at which the bullet reached the stop line of the half it belongs to; -1 if it has not reached it.</returns>
+float BulletStore::middleFraction(std::size_t i, float dt) const {
+    // Wenn von links gestartet muss die Kugel links der Linie bleiben, sonst rechts
+    if (!(status[i] & Simd::BULLET_PAST_STOP)) {
+        return -1.0f;
     }
-    // Wenn von rechts gestartet und jetzt links von der Mitte
-    if (!startedLeft && position.x <= middleX + 5) {
-        return true;
+
+    float stopX = getStopX();
+    float startX = x[i] - vx[i] * dt;
+    bool alreadyThere = leftSide ? startX >= stopX : startX <= stopX;
+    if (alreadyThere) {
+        return 0.0f;
     }
-    return false;
+    return (stopX - startX) / (x[i] - startX);
+}
+
+/// <summary>
+/// Determines whether the bullet at the specified index hit an enemy during the last step, by sweeping the bullet along its path relative to the moving enemy. Hits are found at any step length.
+/// </summary>
+/// <param name="i">The index of the bullet.</param>
+/// <param name="dt">The duration of the last step, in seconds.</param>
+/// <param name="enemies">The enemy store containing the enemy.</param>
+/// <param name="enemy">The index of the enemy to check for a collision with the bullet.</param>
+/// <returns>The fraction of the last step, between 0 and 1, at which the bullet first touched the enemy; -1 if it missed.</returns>
+float BulletStore::sweepHit(std::size_t i, float dt, const EnemyStore& enemies, std::size_t enemy) const {
+    sf::Vector2f end = getPosition(i) - enemies.getPosition(enemy);
+    sf::Vector2f start = end - sf::Vector2f(vx[i] - enemies.vx[enemy], vy[i] - enemies.vy[enemy]) * dt;
+    return sweepCircle(start, end, sf::Vector2f(0, 0), BULLET_RADIUS + ENEMY_RADIUS);
+}
+
+/// <summary>
+/// Writes all bullets, so that loadState can continue exactly from here. The pool size is fixed and not part of the state.
+/// </summary>
+/// <param name="state">The state to append to.</param>
+void BulletStore::saveState(SimulationState& state) const {
+    state.write(static_cast<std::uint64_t>(dropped));
+    state.writeArray(x);
+    state.writeArray(y);
+    state.writeArray(vx);
+    state.writeArray(vy);
+    state.writeArray(status);
 }
 
 /// <summary>
-/// Determines whether the bullet has hit the specified enemy based on their positions and radii.
+/// Restores the bullets written by saveState. The state may come from a file, so it is only taken over if all arrays have the same length and fit into the pool; otherwise the pool is left empty.
 /// </summary>
-/// <param name="enemy">A reference to the Enemy object to check for a collision with the bullet.</param>
-/// <returns>true if the bullet and enemy are colliding; otherwise, false.</returns>
-bool Bullet::checkHit(Enemy& enemy) {
-    return distance(position, enemy.getPosition()) < (BULLET_RADIUS + ENEMY_RADIUS);
+/// <param name="in">The reader positioned at the saved bullets.</param>
+/// <returns>true if the state was read completely and is consistent; otherwise, false.</returns>
+bool BulletStore::loadState(StateReader& in) {
+    std::uint64_t savedDropped = 0;
+    bool valid = in.read(savedDropped) &&
+        in.readArray(x) && in.readArray(y) && in.readArray(vx) && in.readArray(vy) && in.readArray(status) &&
+        x.size() <= capacity && y.size() == x.size() && vx.size() == x.size() && vy.size() == x.size() && status.size() == x.size();
+    if (!valid) {
+        clear();
+        return false;
+    }
+    dropped = static_cast<std::size_t>(savedDropped);
+    return true;
 }
\ No newline at end of file
@@ -1,49 +1,163 @@
 #include "../include/Enemy.h"
 #include "../include/Vector2Utils.h"
 #include "../include/Constants.h"
+#include "../include/SimdKernels.h"
+#include "../include/SimulationState.h"
+#include <algorithm>
+#include <cmath>
 
 using namespace Constants;
 using namespace Utils;
 
 /// <summary>
-/// Constructs an Enemy object at the specified position and assigns a target Player.
+/// Constructs an empty enemy pool and allocates room for the given number of enemies up front, so that adding enemies never allocates.
 /// </summary>
-/// <param name="x">The x-coordinate of the enemy's initial position.</param>
-/// <param name="y">The y-coordinate of the enemy's initial position.</param>
-/// <param name="t">A pointer to the Player object that is the enemy's target.</param>
-Enemy::Enemy(float x, float y, Player* t) : position(x, y), target(t) {
-    shape.setRadius(ENEMY_RADIUS);
-    shape.setFillColor(sf::Color(170, 170, 170));
-    shape.setOrigin(ENEMY_RADIUS, ENEMY_RADIUS);
-    shape.setPosition(position);
+/// <param name="capacity">The maximum number of enemies.</param>
+EnemyStore::EnemyStore(std::size_t capacity) : capacity(0), dropped(0) {
+    reserve(capacity);
 }
 
 /// <summary>
-/// Updates the enemy's position to move toward its target based on the elapsed time.
+/// Raises the maximum number of enemies and allocates the room for them, up to ENEMY_MAX_CAPACITY. Meant for setup, e.g. before spawning a large horde; a smaller value has no effect.
 /// </summary>
-/// <param name="dt">The time elapsed since the last update, in seconds.</param>
-void Enemy::update(float dt) {
-    if (target) {
-        sf::Vector2f direction = target->getPosition() - position;
-        direction = normalize(direction);
-        position += direction * ENEMY_SPEED * dt;
-        shape.setPosition(position);
+/// <param name="newCapacity">The new maximum number of enemies.</param>
+void EnemyStore::reserve(std::size_t newCapacity) {
+    newCapacity = std::min<std::size_t>(newCapacity, ENEMY_MAX_CAPACITY);
+    if (newCapacity <= capacity) {
+        return;
+    }
+    capacity = newCapacity;
+    x.reserve(capacity);
+    y.reserve(capacity);
+    vx.reserve(capacity);
+    vy.reserve(capacity);
+}
+
+/// <summary>
+/// Adds an enemy at the specified position, unless the pool is full. A full pool drops the new enemy and counts it, so that existing enemies are never disturbed.
+/// </summary>
+/// <param name="posX">The x-coordinate of the enemy's initial position.</param>
+/// <param name="posY">The y-coordinate of the enemy's initial position.</param>
+/// <returns>true if the enemy was added; false if the pool was full.</returns>
+bool EnemyStore::add(float posX, float posY) {
+    if (size() >= capacity) {
+        dropped++;
+        return false;
     }
+    x.push_back(posX);
+    y.push_back(posY);
+    vx.push_back(0.0f);
+    vy.push_back(0.0f);
+    return true;
 }
 
 /// <summary>
-/// Draws the enemy's shape onto the specified render window.
+/// Removes the enemy at the specified index in O(1) by moving the last enemy into its slot. The order of enemies is not preserved; when iterating, do not advance the index after a removal, because the slot now holds the former last enemy.
 /// </summary>
-/// <param name="window">The SFML render window where the enemy will be drawn.</param>
-void Enemy::draw(sf::RenderWindow& window) {
-    window.draw(shape);
+/// <param name="i">The index of the enemy to remove.</param>
+void EnemyStore::remove(std::size_t i) {
+    std::size_t last = size() - 1;
+    x[i] = x[last];
+    y[i] = y[last];
+    vx[i] = vx[last];
+    vy[i] = vy[last];
+
+    x.pop_back();
+    y.pop_back();
+    vx.pop_back();
+    vy.pop_back();
 }
 
 /// <summary>
-/// Checks if the enemy is colliding with the player.
+/// Removes all enemies. The pool keeps its memory.
+/// </summary>
+void EnemyStore::clear() {
+    x.clear();
+    y.clear();
+    vx.clear();
+    vy.clear();
+}
+
+/// <summary>
+/// Moves the enemies in the given range toward the target player based on the elapsed time. Ranges that do not overlap can be updated in parallel. Without obstacles all enemies head straight for the player, using the batched SIMD kernel. Otherwise each enemy looks up its cell in the flow field: enemies with a clear view still head straight for the player, the others follow the field around the obstacles.
+/// </summary>
+/// <param name="dt">The time elapsed since the last update, in seconds.</param>
+/// <param name="target">The player chased by the enemies.</param>
+/// <param name="field">The flow field toward the target player.</param>
+/// <param name="begin">The index of the first enemy to update.</param>
+/// <param name="end">The index after the last enemy to update.</param>
+void EnemyStore::update(float dt, const Player& target, const FlowField& field, std::size_t begin, std::size_t end) {
+    const sf::Vector2f targetPosition = target.getPosition();
+    if (!field.hasObstacles()) {
+        Simd::seek(x.data() + begin, y.data() + begin, vx.data() + begin, vy.data() + begin, end - begin,
+            targetPosition.x, targetPosition.y, ENEMY_SPEED, dt);
+        return;
+    }
+
+    for (std::size_t i = begin; i < end; i++) {
+        if (field.isDirect(x[i], y[i])) {
+            // Wie Simd::seek: direkt auf den Spieler zu
+            float dx = targetPosition.x - x[i];
+            float dy = targetPosition.y - y[i];
+            float lengthSq = dx * dx + dy * dy;
+            float scale = lengthSq > 0.0f ? ENEMY_SPEED * rsqrt(lengthSq) : 0.0f;
+            vx[i] = dx * scale;
+            vy[i] = dy * scale;
+        }
+        else {
+            sf::Vector2f direction = field.getDirection(x[i], y[i]);
+            vx[i] = direction.x * ENEMY_SPEED;
+            vy[i] = direction.y * ENEMY_SPEED;
+        }
+        x[i] += vx[i] * dt;
+        y[i] += vy[i] * dt;
+    }
+}
+
+/// <summary>
+/// Checks the enemies in the given range for a collision with the player at once, using the batched SIMD kernel. The range must start at a multiple of 64, so that ranges checked in parallel write to different words of the bitmask.
 /// </summary>
 /// <param name="player">A reference to the Player object to check for collision.</param>
-/// <returns>true if the enemy and player are colliding; otherwise, false.</returns>
-bool Enemy::checkCollision(Player& player) {
-    return distance(position, player.getPosition()) < (PLAYER_RADIUS + ENEMY_RADIUS);
+/// <param name="hits">A bitmask with one bit per enemy, 64 enemies per word, sized for all enemies; the words of the range receive the result. A set bit means the enemy and player are colliding.</param>
+/// <param name="begin">The index of the first enemy to check; a multiple of 64.</param>
+/// <param name="end">The index after the last enemy to check.</param>
+void EnemyStore::checkCollisions(const Player& player, std::vector<std::uint64_t>& hits, std::size_t begin, std::size_t end) const {
+    const sf::Vector2f position = player.getPosition();
+    Simd::overlapMask(x.data() + begin, y.data() + begin, end - begin, position.x, position.y,
+        PLAYER_RADIUS + ENEMY_RADIUS, hits.data() + begin / 64);
+}
+
+/// <summary>
+/// Writes all enemies and the pool size, so that loadState can continue exactly from here; the pool size decides which later spawns are dropped.
+/// </summary>
+/// <param name="state">The state to append to.</param>
+void EnemyStore::saveState(SimulationState& state) const {
+    state.write(static_cast<std::uint64_t>(capacity));
+    state.write(static_cast<std::uint64_t>(dropped));
+    state.writeArray(x);
+    state.writeArray(y);
+    state.writeArray(vx);
+    state.writeArray(vy);
+}
+
+/// <summary>
+/// Restores the enemies and the pool size written by saveState. The memory of the pool is only ever enlarged. The state may come from a file, so it is only taken over if the pool size is within ENEMY_MAX_CAPACITY and all arrays have the same length within the pool size; otherwise the pool is left empty.
+/// </summary>
+/// <param name="in">The reader positioned at the saved enemies.</param>
+/// <returns>true if the state was read completely and is consistent; otherwise, false.</returns>
+bool EnemyStore::loadState(StateReader& in) {
+    std::uint64_t savedCapacity = 0, savedDropped = 0;
+    bool valid = in.read(savedCapacity) && in.read(savedDropped) && savedCapacity <= ENEMY_MAX_CAPACITY &&
+        in.readArray(x) && in.readArray(y) && in.readArray(vx) && in.readArray(vy) &&
+        x.size() <= savedCapacity && y.size() == x.size() && vx.size() == x.size() && vy.size() == x.size();
+    if (!valid) {
+        clear();
+        return false;
+    }
+
+    // Platz für den Pool erst nach der Prüfung, reserve() behält die Elemente
+    reserve(static_cast<std::size_t>(savedCapacity));
+    capacity = static_cast<std::size_t>(savedCapacity);
+    dropped = static_cast<std::size_t>(savedDropped);
+    return true;
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+#include "../include/FlowField.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+/// <summary>
+/// Constructs a flow field over the given rectangle without obstacles. All memory is allocated here, so that updating the field does not allocate.
+/// </summary>
+/// <param name="left">The x-coordinate of the left edge of the covered area.</param>
+/// <param name="top">The y-coordinate of the top edge of the covered area.</param>
+/// <param name="width">The width of the covered area.</param>
+/// <param name="height">The height of the covered area.</param>
+/// <param name="cellSize">The edge length of a cell.</param>
+FlowField::FlowField(float left, float top, float width, float height, float cellSize)
+    : originX(left), originY(top), cellSize(cellSize), inverseCellSize(1.0f / cellSize),
+    columns(std::max(1, static_cast<int>(std::ceil(width / cellSize)))),
+    rows(std::max(1, static_cast<int>(std::ceil(height / cellSize)))),
+    targetCell(-1),
+    obstacles(false) {
+    std::size_t cellCount = static_cast<std::size_t>(columns) * rows;
+    blocked.assign(cellCount, 0);
+    cost.assign(cellCount, UNREACHABLE);
+    direct.assign(cellCount, 1);
+    directionX.assign(cellCount, 0.0f);
+    directionY.assign(cellCount, 0.0f);
+    // Jede Zelle kann von jedem ihrer 8 Nachbarn aus eingereiht werden
+    open.reserve(cellCount * 8);
+}
+
+bool FlowField::isFree(int c, int r) const {
+    return c >= 0 && c < columns && r >= 0 && r < rows && !blocked[r * columns + c];
+}
+
+/// <summary>
+/// Marks all cells touched by the given rectangle as blocked. The field is recomputed on the next update.
+/// </summary>
+/// <param name="left">The x-coordinate of the left edge of the obstacle.</param>
+/// <param name="top">The y-coordinate of the top edge of the obstacle.</param>
+/// <param name="width">The width of the obstacle.</param>
+/// <param name="height">The height of the obstacle.</param>
+void FlowField::block(float left, float top, float width, float height) {
+    for (int r = row(top); r <= row(top + height); r++) {
+        for (int c = column(left); c <= column(left + width); c++) {
+            blocked[r * columns + c] = 1;
+        }
+    }
+    obstacles = true;
+    targetCell = -1;
+}
+
+/// <summary>
+/// Moves the target of the field. The field is only recomputed when the target enters a different cell, and not at all while there are no obstacles, because then every enemy heads straight for the target.
+/// </summary>
+/// <param name="target">The position the enemies are heading for.</param>
+/// <returns>true if the field was recomputed; otherwise, false.</returns>
+bool FlowField::update(const sf::Vector2f& target) {
+    int cell = cellAt(target.x, target.y);
+    if (!obstacles || cell == targetCell) {
+        return false;
+    }
+    targetCell = cell;
+    rebuild();
+    return true;
+}
+
+/// <summary>
+/// Returns the direction to follow from the given position: toward the neighbouring cell that lies on the shortest path to the target.
+/// </summary>
+/// <param name="x">The x-coordinate of the position.</param>
+/// <param name="y">The y-coordinate of the position.</param>
+/// <returns>A unit vector, or the zero vector if the target cannot be reached from this cell.</returns>
+sf::Vector2f FlowField::getDirection(float x, float y) const {
+    int cell = cellAt(x, y);
+    return sf::Vector2f(directionX[cell], directionY[cell]);
+}
+
+/// <summary>
+/// Checks whether the straight line between the centers of two cells crosses no blocked cell, by walking the cells along the line.
+/// </summary>
+/// <param name="from">The index of the start cell.</param>
+/// <param name="to">The index of the end cell.</param>
+/// <returns>true if the line is free; otherwise, false.</returns>
+bool FlowField::lineOfSight(int from, int to) const {
+    int c0 = from % columns, r0 = from / columns;
+    int c1 = to % columns, r1 = to / columns;
+    int dc = std::abs(c1 - c0), dr = std::abs(r1 - r0);
+    int stepC = c0 < c1 ? 1 : -1, stepR = r0 < r1 ? 1 : -1;
+
+    // Alle Zellen entlang der Linie, bei Ecken beide Nachbarn
+    int error = dc - dr;
+    while (c0 != c1 || r0 != r1) {
+        int doubled = 2 * error;
+        if (doubled > -dr && doubled < dc) {
+            if (!isFree(c0 + stepC, r0) || !isFree(c0, r0 + stepR)) {
+                return false;
+            }
+        }
+        if (doubled > -dr) {
+            error -= dr;
+            c0 += stepC;
+        }
+        if (doubled < dc) {
+            error += dc;
+            r0 += stepR;
+        }
+        if (blocked[r0 * columns + c0]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// <summary>
+/// Recomputes the path costs from every cell to the target cell with Dijkstra's algorithm over 8 neighbours, then stores for each cell whether it sees the target directly and otherwise the direction to its cheapest neighbour. Diagonal moves must not cut the corner of a blocked cell.
+/// </summary>
+void FlowField::rebuild() {
+    static const int OFFSET_C[8] = { 1, -1, 0, 0, 1, 1, -1, -1 };
+    static const int OFFSET_R[8] = { 0, 0, 1, -1, 1, -1, 1, -1 };
+    static const std::uint32_t STEP_COST[8] = { 10, 10, 10, 10, 14, 14, 14, 14 };
+
+    // Kosten vom Ziel aus ausbreiten
+    std::fill(cost.begin(), cost.end(), UNREACHABLE);
+    open.clear();
+    cost[targetCell] = 0;
+    open.push_back(static_cast<std::uint64_t>(targetCell));
+
+    while (!open.empty()) {
+        std::pop_heap(open.begin(), open.end(), std::greater<std::uint64_t>());
+        std::uint64_t entry = open.back();
+        open.pop_back();
+
+        int cell = static_cast<int>(entry & 0xFFFFFFFFu);
+        std::uint32_t cellCost = static_cast<std::uint32_t>(entry >> 32);
+        if (cellCost > cost[cell]) {
+            continue; // Veralteter Eintrag
+        }
+
+        int c = cell % columns, r = cell / columns;
+        for (int k = 0; k < 8; k++) {
+            int nc = c + OFFSET_C[k], nr = r + OFFSET_R[k];
+            if (!isFree(nc, nr) || (k >= 4 && (!isFree(nc, r) || !isFree(c, nr)))) {
+                continue;
+            }
+            int neighbour = nr * columns + nc;
+            std::uint32_t newCost = cellCost + STEP_COST[k];
+            if (newCost < cost[neighbour]) {
+                cost[neighbour] = newCost;
+                open.push_back(static_cast<std::uint64_t>(newCost) << 32 | static_cast<std::uint32_t>(neighbour));
+                std::push_heap(open.begin(), open.end(), std::greater<std::uint64_t>());
+            }
+        }
+    }
+
+    // Richtung je Zelle: direkt bei freier Sicht, sonst zum günstigsten Nachbarn
+    const float diagonal = 0.70710678f;
+    for (int cell = 0; cell < columns * rows; cell++) {
+        directionX[cell] = 0.0f;
+        directionY[cell] = 0.0f;
+        direct[cell] = cost[cell] == UNREACHABLE || blocked[cell] || lineOfSight(cell, targetCell);
+        if (direct[cell]) {
+            continue;
+        }
+
+        int c = cell % columns, r = cell / columns;
+        std::uint32_t best = cost[cell];
+        for (int k = 0; k < 8; k++) {
+            int nc = c + OFFSET_C[k], nr = r + OFFSET_R[k];
+            if (!isFree(nc, nr) || (k >= 4 && (!isFree(nc, r) || !isFree(c, nr)))) {
+                continue;
+            }
+            std::uint32_t neighbourCost = cost[nr * columns + nc];
+            if (neighbourCost < best) {
+                best = neighbourCost;
+                float scale = k >= 4 ? diagonal : 1.0f;
+                directionX[cell] = OFFSET_C[k] * scale;
+                directionY[cell] = OFFSET_R[k] * scale;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "../include/FrameArena.h"
+#include <cstdlib>
+#include <new>
+
+/// <summary>
+/// Constructs a frame arena with a buffer of the given size. Allocations beyond the buffer fall back to the global heap, which the debug allocation counter reports.
+/// </summary>
+/// <param name="capacity">The size of the buffer, in bytes.</param>
+FrameArena::FrameArena(std::size_t capacity)
+    : buffer(new unsigned char[capacity]),
+    resource(buffer.get(), capacity) {
+}
+
+/// <summary>
+/// Releases everything allocated from the arena at once, so that the next frame starts again at the beginning of the buffer. Objects using the arena must not outlive this call.
+/// </summary>
+void FrameArena::reset() {
+    resource.release();
+}
+
+#ifdef QT_COUNT_ALLOCATIONS
+
+// Je Thread, damit andere Threads die Messung einer Schleife nicht verfälschen
+static thread_local std::size_t threadAllocations = 0;
+
+void* operator new(std::size_t size) {
+    threadAllocations++;
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+#endif
+
+namespace Memory {
+    /// <summary>
+    /// Returns the number of global heap allocations the calling thread has made through operator new since it started. Counting per thread keeps allocations of other threads out of a loop's check. Only counted in debug builds or when QT_COUNT_ALLOCATIONS is defined.
+    /// </summary>
+    /// <returns>The number of allocations of the calling thread, or 0 if allocations are not counted.</returns>
+    std::size_t getThreadAllocationCount() {
+#ifdef QT_COUNT_ALLOCATIONS
+        return threadAllocations;
+#else
+        return 0;
+#endif
+    }
+}
\ No newline at end of file
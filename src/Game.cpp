@@ -1,398 +1,359 @@
 #include "../include/Game.h"
 #include "../include/Constants.h"
+#include "../include/FrameArena.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iostream>
+#include <random>
+#include <thread>
 
 using namespace Constants;
 
 /// <summary>
-/// Initializes a new instance of the Game class, setting up the game window, players, weapon, random number generator, and user interface elements. Also checks for controller connection and configures the game state accordingly.
+/// Opens the replay file, if there is one, and picks the seed of the match: the recorded one for a replay, otherwise a random one.
 /// </summary>
-Game::Game()
-    : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Quick! Throw!"),
-    player1(WINDOW_WIDTH / 4.0f, WINDOW_HEIGHT / 2.0f, true, 0),
-    player2(3 * WINDOW_WIDTH / 4.0f, WINDOW_HEIGHT / 2.0f, false),
-    weapon(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f),
-    rng(std::random_device{}()),
-    spawnY(50.0f, WINDOW_HEIGHT - 50.0f),
-    gameOver(false),
-    fontLoaded(false) {
-
-    window.setFramerateLimit(60);
-
-    // Controller-Info
-    if (sf::Joystick::isConnected(0)) {
-        std::cout << "Controller verbunden: "
-            << sf::Joystick::getIdentification(0).name.toAnsiString() << std::endl;
-    }
-    else {
-        std::cout << "Kein Controller gefunden! Spieler 1 nutzt auch Tastatur." << std::endl;
-        player1.setIsControllerPlayer(false);
+/// <param name="replay">The reader that opens the replay file.</param>
+/// <param name="replayFile">The path of the replay file, or nullptr to play live.</param>
+/// <returns>The seed for the simulation.</returns>
+static unsigned int openReplay(ReplayReader& replay, const char* replayFile) {
+    if (replayFile) {
+        if (replay.open(replayFile)) {
+            return replay.getHeader().seed;
+        }
+        std::cout << "Aufnahme " << replayFile << " kann nicht gelesen werden, starte normales Spiel" << std::endl;
     }
-
-    // Mittellinie
-    divider.setSize(sf::Vector2f(8, static_cast<float>(WINDOW_HEIGHT)));
-    divider.setPosition(WINDOW_WIDTH / 2.0f - 4, 0);
-    divider.setFillColor(sf::Color(170, 170, 170));
-
-    // UI initialisieren
-    initializeUI();
-
-    // Spieler 1 startet mit der Waffe
-    weapon.checkPickup(player1);
-
-    updateControlsText();
+    return std::random_device{}();
 }
 
 /// <summary>
-/// Initializes the user interface elements for the game, including fonts, health displays, control instructions, game over text, and health bars for both players.
+/// Hosts or joins an online match if the options ask for one and picks the seed of the match: a random one chosen by the host, which the joining peer takes over. If no peer can be reached, the game starts as a local match with a random seed.
 /// </summary>
-void Game::initializeUI() {
-    // Font laden
-    fontLoaded = font.loadFromFile("C:/Windows/Fonts/arial.ttf");
-
-    if (fontLoaded) {
-        // Health-Texte
-        healthText1.setFont(font);
-        healthText1.setCharacterSize(24);
-        healthText1.setPosition(10, 10);
-        healthText1.setFillColor(sf::Color::Black);
-
-        healthText2.setFont(font);
-        healthText2.setCharacterSize(24);
-        healthText2.setPosition(static_cast<float>(WINDOW_WIDTH - 150), 10);
-        healthText2.setFillColor(sf::Color::Black);
-
-        // Controls-Text
-        controlsText.setFont(font);
-        controlsText.setCharacterSize(16);
-        controlsText.setPosition(10, WINDOW_HEIGHT - 80.0f);
-        controlsText.setFillColor(sf::Color(60, 60, 60));
-
-        // Game Over Text
-        gameOverText.setFont(font);
-        gameOverText.setCharacterSize(48);
-        gameOverText.setFillColor(sf::Color(105, 24, 27));
-        gameOverText.setString("GAME OVER!");
-        sf::FloatRect textBounds = gameOverText.getLocalBounds();
-        gameOverText.setOrigin(textBounds.width / 2, textBounds.height / 2);
-        gameOverText.setPosition(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f);
+/// <param name="net">The session that connects to the peer.</param>
+/// <param name="options">The host port or the address to join, the tick rate and the rollback window.</param>
+/// <returns>The seed for the simulation.</returns>
+static unsigned int openSession(NetSession& net, const GameOptions& options) {
+    unsigned int seed = std::random_device{}();
+    if (options.hostPort != 0) {
+        NetSettings settings;
+        settings.seed = seed;
+        settings.tickRate = options.tickRate;
+        settings.rollbackWindow = options.rollbackWindow;
+        std::cout << "Warte auf Mitspieler auf Port " << options.hostPort << " ..." << std::endl;
+        if (net.host(options.hostPort, settings)) {
+            return seed;
+        }
     }
-
-    // Lebensbalken
-    for (int i = 0; i < PLAYER_MAX_HEALTH; i++) {
-        sf::RectangleShape bar(sf::Vector2f(30, 10));
-        bar.setFillColor(sf::Color::Black);
-        bar.setPosition(10 + i * 35.0f, 40);
-        healthBars1.push_back(bar);
-
-        sf::RectangleShape bar2(sf::Vector2f(30, 10));
-        bar2.setFillColor(sf::Color::Black);
-        bar2.setPosition(WINDOW_WIDTH - 110.0f + i * 35.0f, 40);
-        healthBars2.push_back(bar2);
+    else if (options.joinAddress) {
+        std::cout << "Verbinde mit " << options.joinAddress << ":" << options.joinPort << " ..." << std::endl;
+        if (net.join(sf::IpAddress(options.joinAddress), options.joinPort)) {
+            return net.getSettings().seed;
+        }
+    }
+    else {
+        return seed;
     }
+    std::cout << "Kein Mitspieler erreicht, starte normales Spiel" << std::endl;
+    return seed;
 }
 
 /// <summary>
-/// Updates the on-screen text displaying the game controls for each player.
+/// Initializes a new instance of the Game class, setting up the game window, the simulation, the input pump, and the renderer. Also checks for controller connection and configures the game state accordingly. When replaying, the seed, tick rate and settings come from the recording instead; in an online match they come from the host, and the match is not recorded.
 /// </summary>
-void Game::updateControlsText() {
-    std::string controls = "P1 (Left): ";
-    if (player1.getIsControllerPlayer()) {
-        controls += "Controller - Sticks: Bewegen/Zielen, RT: Schieen, LT: Werfen";
+/// <param name="options">The tick rate, the latency export, the record and replay files, and the online match to host or join.</param>
+Game::Game(const GameOptions& options)
+    : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Quick! Throw!"),
+    replayFinished(false),
+    replayPaused(false),
+    replaySpeed(std::min(std::max(options.replaySpeed, MIN_REPLAY_SPEED), MAX_REPLAY_SPEED)),
+    simulation(options.replayFile ? openReplay(replay, options.replayFile) : openSession(net, options), true),
+    recordFile(options.recordFile),
+    inputPump(window, inputEvents, sf::Joystick::isConnected(0)),
+    inputCollector(inputEvents, sf::Joystick::isConnected(0)),
+    latencyFile(options.latencyFile),
+    tickRate(options.tickRate),
+    renderer(window),
+    running(false) {
+
+    window.setFramerateLimit(60);
+
+    if (replay.isOpen()) {
+        const ReplayHeader& header = replay.getHeader();
+        tickRate = header.tickRate;
+        simulation.getPlayer1().setIsControllerPlayer(header.player1UsesController);
+        simulation.setInvulnerable(header.invulnerable);
+        simulation.spawnHorde(static_cast<std::size_t>(header.horde));
+        std::cout << "Wiedergabe: " << options.replayFile << " mit " << replaySpeed << "-facher Geschwindigkeit"
+            << (replay.hasIndex() ? ", Pfeiltasten spulen, P pausiert" : ", ohne Index nicht spulbar") << std::endl;
+        if (options.seekTick > 0) {
+            seekReplay(static_cast<long long>(options.seekTick));
+        }
+        return;
+    }
+
+    // Controller-Info
+    if (sf::Joystick::isConnected(0)) {
+        std::cout << "Controller verbunden: "
+            << sf::Joystick::getIdentification(0).name.toAnsiString() << std::endl;
     }
     else {
-        controls += "WASD: Bewegen, Maus: Zielen, E: Schieen, Space: Werfen";
+        std::cout << "Kein Controller gefunden! Spieler 1 nutzt auch Tastatur." << std::endl;
+        simulation.getPlayer1().setIsControllerPlayer(false);
+    }
+
+    // Online: Einstellungen des Hosts. Die Controller-Nutzung gehört zum
+    // Spielstand, bleibt deshalb auf beiden Peers aus.
+    if (net.isConnected()) {
+        const NetSettings& settings = net.getSettings();
+        tickRate = settings.tickRate;
+        simulation.getPlayer1().setIsControllerPlayer(false);
+        simulation.setInvulnerable(settings.invulnerable);
+        simulation.spawnHorde(static_cast<std::size_t>(settings.horde));
+        inputCollector.setOnlinePlayer(net.getLocalPlayer());
+        std::cout << "Online-Partie als Spieler " << net.getLocalPlayer() + 1 << ", Rollback-Fenster "
+            << settings.rollbackWindow << " Schritte" << std::endl;
+        if (recordFile) {
+            std::cout << "Online-Partien werden nicht aufgenommen" << std::endl;
+        }
+        return;
     }
-    controls += "\nP2 (Right): Pfeiltasten: Bewegen, Maus: Zielen, RMB: Schieen, RCtrl: Werfen";
-    controls += "\nR: Neustart";
 
-    if (fontLoaded) {
-        controlsText.setString(controls);
+    // Aufnahme
+    if (recordFile) {
+        ReplayHeader header;
+        header.seed = simulation.getSeed();
+        header.tickRate = tickRate;
+        header.player1UsesController = simulation.getPlayer1().getIsControllerPlayer();
+        if (!recorder.open(recordFile, header, simulation)) {
+            std::cout << "Aufnahme " << recordFile << " kann nicht angelegt werden" << std::endl;
+        }
     }
 }
 
 /// <summary>
-/// Runs the main game loop, handling events, updating game state, and rendering frames while the window is open.
+/// Runs the game while the window is open. The simulation and the renderer each get their own thread; the calling thread, which owns the window, reads the window events and samples the input devices up to INPUT_SAMPLE_RATE times per second, so input reaches the simulation with precise timestamps regardless of how long a step or a frame takes.
 /// </summary>
 void Game::run() {
+    renderer.publish(simulation, std::chrono::steady_clock::now(), 1.0f / tickRate, 1.0f / tickRate);
+    renderer.start();
+    running = true;
+    simulationThread = std::thread(&Game::simulationLoop, this);
+
+    const auto samplePeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(1.0f / INPUT_SAMPLE_RATE));
+    auto nextSample = std::chrono::steady_clock::now();
     while (window.isOpen()) {
-        handleEvents();
-
-        if (!gameOver) {
-            update();
+        // Beim Schließen erst Simulation und Render-Thread anhalten, der
+        // Renderer zeichnet noch ins Fenster
+        if (!inputPump.pump()) {
+            running = false;
+            simulationThread.join();
+            renderer.stop();
+            window.close();
+            finishRecording();
+            reportLatency();
+            if (net.isConnected()) {
+                net.printStats(std::cout);
+            }
+            break;
         }
 
-        render();
+        // Bis zur nächsten Abfrage schlafen, nach einem Hänger nicht nachholen.
+        // sf::sleep stellt unter Windows selbst die Timerauflösung auf 1 ms,
+        // std::this_thread schliefe mit den üblichen 15,6 ms.
+        nextSample = std::max(nextSample + samplePeriod, std::chrono::steady_clock::now());
+        auto wait = nextSample - std::chrono::steady_clock::now();
+        sf::sleep(sf::microseconds(std::chrono::duration_cast<std::chrono::microseconds>(wait).count()));
     }
 }
 
 /// <summary>
-/// Handles all user input events for the game, including keyboard, mouse, and controller actions, as well as window events and game restart logic.
+/// The loop of the simulation thread. The simulation advances in fixed steps driven by an accumulator and publishes a snapshot for the render thread after each pass; at most MAX_CATCHUP_STEPS steps run per pass, and when the simulation stays behind for a few passes the remaining backlog is dropped. Between passes the loop sleeps until the next step is due. A replay runs the same steps, only spaced by the replay speed; steps are never less than a microsecond apart, even for a recording with an extreme tick rate.
 /// </summary>
-void Game::handleEvents() {
-    sf::Event event;
-    while (window.pollEvent(event)) {
-        if (event.type == sf::Event::Closed)
-            window.close();
-
-        if (!gameOver) {
-            if (event.type == sf::Event::KeyPressed) {
-                // Waffe werfen
-                if (event.key.code == sf::Keyboard::Space &&
-                    player1.getHasWeapon() && !player1.getIsControllerPlayer()) {
-                    weapon.throwTo(&player1, &player2);
-                }
-                if (event.key.code == sf::Keyboard::Space && player2.getHasWeapon()) {
-                    weapon.throwTo(&player2, &player1);
-                }
-
-                // Schieen fr Keyboard-Spieler
-                if (event.key.code == sf::Keyboard::E &&
-                    player1.getHasWeapon() && !player1.getIsControllerPlayer()) {
-                    shoot(player1);
-                }
-            }
-
-            // Maus-Schieen
-            if (event.type == sf::Event::MouseButtonPressed) {
-                if (event.mouseButton.button == sf::Mouse::Right && player2.getHasWeapon()) {
-                    shoot(player2);
-                }
-                if (event.mouseButton.button == sf::Mouse::Left &&
-                    player1.getHasWeapon() && !player1.getIsControllerPlayer()) {
-                    shoot(player1);
-                }
-            }
-
-            // Controller Events
-            if (event.type == sf::Event::JoystickConnected) {
-                if (event.joystickConnect.joystickId == 0) {
-                    player1.setIsControllerPlayer(true);
-                    updateControlsText();
-                    std::cout << "Controller verbunden!" << std::endl;
-                }
-            }
-            if (event.type == sf::Event::JoystickDisconnected) {
-                if (event.joystickConnect.joystickId == 0) {
-                    player1.setIsControllerPlayer(false);
-                    updateControlsText();
-                    std::cout << "Controller getrennt!" << std::endl;
-                }
-            }
+void Game::simulationLoop() {
+    const float dt = 1.0f / tickRate;
+    const sf::Time tickTime = std::max(sf::seconds(replay.isOpen() ? dt / replaySpeed : dt), sf::microseconds(1));
+    sf::Time accumulator = sf::Time::Zero;
+    int behindPasses = 0;
+
+#ifdef QT_COUNT_ALLOCATIONS
+    unsigned long long passes = 0, allocatingPasses = 0;
+#endif
+
+    clock.restart();
+    while (running) {
+#ifdef QT_COUNT_ALLOCATIONS
+        std::size_t allocationsBefore = Memory::getThreadAllocationCount();
+#endif
+
+        // Lange Hänger (z.B. Fenster verschieben) nicht nachsimulieren
+        accumulator += std::min(clock.restart(), sf::seconds(MAX_FRAME_TIME));
+
+        // Feste Simulationsschritte. Jeder Schritt übernimmt die Ereignisse bis
+        // zu dem Zeitpunkt, zu dem er fällig war.
+        auto now = std::chrono::steady_clock::now();
+        int steps = 0;
+        while (accumulator >= tickTime && steps < MAX_CATCHUP_STEPS) {
+            accumulator -= tickTime;
+            update(dt, now - std::chrono::microseconds(accumulator.asMicroseconds()));
+            steps++;
         }
 
-        // Neustart
-        if (gameOver && event.type == sf::Event::KeyPressed) {
-            if (event.key.code == sf::Keyboard::R) {
-                restart();
+        // Simulation hinkt hinterher: ohne Pause weiter aufholen, nach einigen
+        // Durchläufen den Rückstand verwerfen, sonst schaukelt er sich auf
+        if (accumulator >= tickTime) {
+            if (++behindPasses > MAX_BEHIND_PASSES) {
+                accumulator = sf::microseconds(accumulator.asMicroseconds() % tickTime.asMicroseconds());
+                behindPasses = 0;
             }
         }
-    }
+        else {
+            behindPasses = 0;
+        }
 
-    // Controller-Eingabe (muss jeden Frame geprft werden)
-    if (!gameOver && player1.getIsControllerPlayer() && sf::Joystick::isConnected(0)) {
-        static bool rtWasPressed = false;
-        static bool ltWasPressed = false;
+        // Neuen Stand an den Render-Thread übergeben. Der letzte Schritt war
+        // um den Rest im Akkumulator früher fällig.
+        if (steps > 0) {
+            auto dueTime = std::chrono::steady_clock::now() - std::chrono::microseconds(accumulator.asMicroseconds());
+            renderer.publish(simulation, dueTime, tickTime.asSeconds(), dt);
+        }
 
-        bool rtPressed = sf::Joystick::getAxisPosition(0, sf::Joystick::Z) > 50 ||
-            sf::Joystick::isButtonPressed(0, 7);
-        if (rtPressed && !rtWasPressed && player1.getHasWeapon()) {
-            shoot(player1);
+#ifdef QT_COUNT_ALLOCATIONS
+        // Debug: im eingeschwungenen Zustand darf kein Durchlauf den Heap benutzen
+        // (nur dieser Thread; die Arbeiter des Thread-Pools zählen nicht mit)
+        std::size_t allocations = Memory::getThreadAllocationCount() - allocationsBefore;
+        passes++;
+        if (allocations > 0 && allocatingPasses++ == 0) {
+            std::cout << "Debug: Durchlauf " << passes << " hat " << allocations << " globale Allokationen" << std::endl;
         }
-        rtWasPressed = rtPressed;
+#endif
 
-        bool ltPressed = sf::Joystick::getAxisPosition(0, sf::Joystick::Z) < -50 ||
-            sf::Joystick::isButtonPressed(0, 6);
-        if (ltPressed && !ltWasPressed && player1.getHasWeapon()) {
-            weapon.throwTo(&player1, &player2);
+        // Bis zum nächsten Schritt schlafen
+        if (accumulator < tickTime) {
+            sf::sleep(tickTime - accumulator - clock.getElapsedTime());
         }
-        ltWasPressed = ltPressed;
     }
+
+#ifdef QT_COUNT_ALLOCATIONS
+    std::cout << "Debug: " << allocatingPasses << " von " << passes << " Durchläufen mit globalen Allokationen" << std::endl;
+#endif
 }
 
 /// <summary>
-/// Updates the game state, including players, weapon, enemies, bullets, UI, and checks for game over conditions.
+/// Builds the input of this step from the queued events and advances the simulation by one fixed step, recording the input if a recording is running. After game over only restart and controller events have an effect. In an online match the session first takes over the peer's inputs, rolling back if needed, and then advances with the local player's input; if the peer is too far behind, the step waits and the events stay queued. The oldest input of the step is timed up to here and handed on to the renderer, which times it up to the frame that first shows it.
 /// </summary>
-void Game::update() {
-    float dt = clock.restart().asSeconds();
-
-    // Spieler updaten
-    player1.update(dt, window);
-    player2.update(dt, window);
-
-    // Waffe updaten
-    weapon.update(dt);
-    weapon.checkPickup(player1);
-    weapon.checkPickup(player2);
-
-    // Gegner spawnen
-    if (spawnClock.getElapsedTime().asSeconds() > ENEMY_SPAWN_INTERVAL) {
-        spawnClock.restart();
-
-        // Spawn auf beiden Seiten
-        float y1 = spawnY(rng);
-        float y2 = spawnY(rng);
-
-        enemies.push_back(Enemy(0, y1, &player1));
-        enemies.push_back(Enemy(static_cast<float>(WINDOW_WIDTH), y2, &player2));
-
-        // Zustzliche Spawns bei vielen Gegnern
-        if (enemies.size() > 10) {
-            float x1 = std::uniform_real_distribution<float>(50, WINDOW_WIDTH / 2.0f - 50)(rng);
-            float x2 = std::uniform_real_distribution<float>(WINDOW_WIDTH / 2.0f + 50, WINDOW_WIDTH - 50)(rng);
-            enemies.push_back(Enemy(x1, 0, &player1));
-            enemies.push_back(Enemy(x2, static_cast<float>(WINDOW_HEIGHT), &player2));
-        }
+/// <param name="dt">The fixed duration of a simulation step, in seconds.</param>
+/// <param name="tickEnd">The wall-clock time at which this step is due.</param>
+void Game::update(float dt, std::chrono::steady_clock::time_point tickEnd) {
+    if (replay.isOpen()) {
+        replayStep();
+        return;
     }
 
-    // Gegner updaten und Kollisionen prfen
-    for (auto it = enemies.begin(); it != enemies.end();) {
-        it->update(dt);
-
-        if (it->checkCollision(player1)) {
-            player1.takeDamage();
-            it = enemies.erase(it);
-        }
-        else if (it->checkCollision(player2)) {
-            player2.takeDamage();
-            it = enemies.erase(it);
-        }
-        else {
-            ++it;
+    // Online erst die Eingaben des Mitspielers übernehmen
+    if (net.isConnected()) {
+        net.synchronize(simulation);
+        if (!net.canAdvance()) {
+            return;
         }
     }
 
-    // Kugeln updaten
-    for (auto it = bullets.begin(); it != bullets.end();) {
-        it->update(dt);
-
-        bool shouldRemove = false;
+    // Eingaben sammeln
+    TickInput input = inputCollector.collect(simulation, dt, tickEnd);
 
-        // Prfe ob Kugel die Mittellinie erreicht hat
-        if (it->shouldStopAtMiddle()) {
-            shouldRemove = true;
-        }
+    // Spiellogik
+    if (net.isConnected()) {
+        net.advance(simulation, net.getLocalPlayer() == 0 ? input.player1 : input.player2, inputCollector.getRestarted());
+    }
+    else {
+        simulation.step(dt, input);
+    }
+    if (recorder.isOpen()) {
+        ReplayTick tick;
+        tick.input = input;
+        tick.restart = inputCollector.getRestarted();
+        tick.player1UsesController = simulation.getPlayer1().getIsControllerPlayer();
+        recorder.write(tick, simulation);
+    }
 
-        // Treffer auf Gegner prfen
-        if (!shouldRemove) {
-            for (auto enemyIt = enemies.begin(); enemyIt != enemies.end();) {
-                if (it->checkHit(*enemyIt)) {
-                    enemyIt = enemies.erase(enemyIt);
-                    shouldRemove = true;
-                    break;
-                }
-                else {
-                    ++enemyIt;
-                }
-            }
-        }
+    if (inputCollector.getHasEvents()) {
+        stepLatency.record(std::chrono::steady_clock::now() - inputCollector.getOldestEvent());
+        renderer.addInput(inputCollector.getOldestEvent());
+    }
+}
 
-        if (shouldRemove || it->isOutOfBounds()) {
-            it = bullets.erase(it);
+/// <summary>
+/// Advances the simulation by the next step of the replay. Device input only controls the replay: seek events jump by REPLAY_SEEK_SECONDS, pause events stop and resume it, everything else is discarded. At the end of the recording the simulation stays at its last state and the final checksum is printed, for comparison with the one printed when the recording was made.
+/// </summary>
+void Game::replayStep() {
+    while (const InputEvent* event = inputEvents.front()) {
+        if (event->type == InputEvent::Type::Seek) {
+            seekReplay(static_cast<long long>(event->value.x * tickRate));
         }
-        else {
-            ++it;
+        else if (event->type == InputEvent::Type::Pause) {
+            replayPaused = !replayPaused;
         }
+        inputEvents.pop();
     }
-
-    // UI updaten
-    if (fontLoaded) {
-        healthText1.setString("P1 Health: " + std::to_string(player1.getHealth()));
-        healthText2.setString("P2 Health: " + std::to_string(player2.getHealth()));
+    if (replayPaused) {
+        return;
     }
 
-    // Game Over prfen
-    if (!player1.isAlive() || !player2.isAlive()) {
-        gameOver = true;
+    ReplayTick tick;
+    if (replay.read(tick)) {
+        applyReplayTick(simulation, replay.getHeader(), tick);
+    }
+    else if (!replayFinished) {
+        replayFinished = true;
+        std::cout << "Wiedergabe beendet nach " << simulation.getTickCount() << " Ticks, Prüfsumme "
+            << std::hex << stateChecksum(simulation) << std::dec << std::endl;
     }
 }
 
 /// <summary>
-/// Fires a bullet from the specified player if they have a weapon.
+/// Jumps forward or back in the replay through the closest keyframe. After a jump back from the end the replay continues and prints the end checksum again when it gets there.
 /// </summary>
-/// <param name="player">Reference to the player who is attempting to shoot.</param>
-void Game::shoot(Player& player) {
-    if (player.getHasWeapon()) {
-        sf::Vector2f spawnPos = player.getPosition() + player.getAimDirection() * 30.0f;
-        bullets.push_back(Bullet(spawnPos.x, spawnPos.y, player.getAimDirection()));
+/// <param name="ticks">The number of steps to jump; negative to jump back.</param>
+void Game::seekReplay(long long ticks) {
+    long long target = std::max(0LL, static_cast<long long>(replay.getTick()) + ticks);
+    if (!replay.seek(simulation, static_cast<std::uint64_t>(target))) {
+        std::cout << "Aufnahme hat keinen Index oder ist beschädigt, Sprung nicht möglich" << std::endl;
+        return;
     }
+    replayFinished = false;
 }
 
 /// <summary>
-/// Resets the game state to its initial configuration, including players, weapon, enemies, and bullets.
+/// Closes the recording, if one is running, and prints its final checksum. Only called after the simulation thread has stopped.
 /// </summary>
-void Game::restart() {
-    // Spieler zurcksetzen
-    player1 = Player(WINDOW_WIDTH / 4.0f, WINDOW_HEIGHT / 2.0f,
-        sf::Joystick::isConnected(0), 0);
-    player2 = Player(3 * WINDOW_WIDTH / 4.0f, WINDOW_HEIGHT / 2.0f, false);
-
-    // Waffe zurcksetzen
-    weapon = Weapon(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f);
-    weapon.checkPickup(player1);
-
-    // Listen leeren
-    enemies.clear();
-    bullets.clear();
-
-    // Spiel fortsetzen
-    gameOver = false;
-    spawnClock.restart();
-    updateControlsText();
+void Game::finishRecording() {
+    if (!recorder.isOpen()) {
+        return;
+    }
+    if (recorder.close()) {
+        std::cout << "Aufnahme: " << recordFile << ", Prüfsumme " << std::hex << stateChecksum(simulation) << std::dec << std::endl;
+    }
+    else {
+        std::cout << "Aufnahme " << recordFile << " unvollständig geschrieben" << std::endl;
+    }
 }
 
 /// <summary>
-/// Renders all game elements and the user interface to the game window.
+/// Prints the percentiles of the input latency, from the input to the step that applies it and to the frame that first shows the result, and writes them to the CSV file if one was given. Only called after the simulation and render threads have stopped.
 /// </summary>
-void Game::render() {
-    window.clear(sf::Color::White);
-
-    // Mittellinie
-    window.draw(divider);
-
-    // Spieler
-    player1.draw(window);
-    player2.draw(window);
-
-    // Waffe
-    weapon.draw(window);
-
-    // Gegner
-    for (auto& enemy : enemies) {
-        enemy.draw(window);
-    }
-
-    // Kugeln
-    for (auto& bullet : bullets) {
-        bullet.draw(window);
-    }
-
-    // UI
-    if (fontLoaded) {
-        window.draw(healthText1);
-        window.draw(healthText2);
-        window.draw(controlsText);
-
-        if (gameOver) {
-            window.draw(gameOverText);
-
-            // Restart-Hinweis
-            sf::Text restartText("Press R to Restart", font, 24);
-            restartText.setFillColor(sf::Color::Black);
-            sf::FloatRect bounds = restartText.getLocalBounds();
-            restartText.setOrigin(bounds.width / 2, bounds.height / 2);
-            restartText.setPosition(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f + 60);
-            window.draw(restartText);
+void Game::reportLatency() const {
+    const LatencyStats& frameLatency = renderer.getDisplayLatency();
+    stepLatency.print(std::cout, "Eingabe bis Schritt");
+    frameLatency.print(std::cout, "Eingabe bis Bild");
+
+    if (latencyFile) {
+        std::ofstream out(latencyFile);
+        LatencyStats::writeCsvHeader(out);
+        stepLatency.writeCsvRow(out, "input_to_step");
+        frameLatency.writeCsvRow(out, "input_to_display");
+        if (!out) {
+            std::cout << "Latenz-Export nach " << latencyFile << " fehlgeschlagen" << std::endl;
         }
     }
-
-    // Lebensbalken
-    for (int i = 0; i < player1.getHealth(); i++) {
-        window.draw(healthBars1[i]);
-    }
-    for (int i = 0; i < player2.getHealth(); i++) {
-        window.draw(healthBars2[i]);
-    }
-
-    window.display();
 }
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "../include/Headless.h"
+#include "../include/Simulation.h"
+#include "../include/Vector2Utils.h"
+#include "../include/Constants.h"
+#include "../include/Replay.h"
+#include "../include/Netplay.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+
+using namespace Constants;
+
+/// <summary>
+/// Generates synthetic input for a player: circles around or walks to the weapon lying on its side, aims at the closest enemy on its own side, shoots regularly and passes the weapon on after a while.
+/// </summary>
+/// <param name="simulation">The simulation whose state the input is based on.</param>
+/// <param name="player">The player for whom the input is generated.</param>
+/// <param name="phase">Offset so that both players do not move in lockstep.</param>
+/// <param name="tickRate">Simulation steps per second, used to keep the bot's timing independent of the tick rate.</param>
+/// <returns>The input of the player for the next step.</returns>
+static PlayerInput autopilot(const Simulation& simulation, const Player& player, float phase, float tickRate) {
+    PlayerInput input;
+    unsigned long long tick = simulation.getTickCount();
+    float t = tick / tickRate + phase;
+
+    // Etwa 8 Schüsse pro Sekunde, alle 3 Sekunden werfen
+    unsigned long long shootInterval = std::max(1ULL, static_cast<unsigned long long>(tickRate / 8.0f));
+    unsigned long long throwInterval = std::max(1ULL, static_cast<unsigned long long>(tickRate * 3.0f));
+
+    bool isLeftSide = player.getPosition().x < WINDOW_WIDTH / 2.0f;
+
+    // Liegende Waffe auf der eigenen Seite holen, sonst im Kreis laufen
+    const Weapon& weapon = simulation.getWeapon();
+    if (!weapon.hasHolder() && (weapon.getPosition().x < WINDOW_WIDTH / 2.0f) == isLeftSide) {
+        input.move = weapon.getPosition() - player.getPosition();
+    }
+    else {
+        input.move = sf::Vector2f(std::cos(t), std::sin(t));
+    }
+
+    // Nächsten Gegner auf der eigenen Seite anvisieren
+    float bestDistance = -1.0f;
+    const EnemyStore& enemies = simulation.getHalf(isLeftSide ? 0 : 1).enemies;
+    for (std::size_t i = 0; i < enemies.size(); i++) {
+        sf::Vector2f offset = enemies.getPosition(i) - player.getPosition();
+        float d = offset.x * offset.x + offset.y * offset.y;
+        if (bestDistance < 0 || d < bestDistance) {
+            bestDistance = d;
+            input.aim = offset;
+        }
+    }
+
+    // Schießen und ab und zu die Waffe weitergeben
+    input.shoot = bestDistance >= 0 && tick % shootInterval == 0;
+    input.throwWeapon = tick % throwInterval == 0;
+    return input;
+}
+
+/// <summary>
+/// Generates synthetic input for both players for the next simulation step.
+/// </summary>
+/// <param name="simulation">The simulation whose state the input is based on.</param>
+/// <param name="tickRate">Simulation steps per second.</param>
+/// <returns>The input of both players for the next step.</returns>
+TickInput autopilotInput(const Simulation& simulation, float tickRate) {
+    TickInput input;
+    input.player1 = autopilot(simulation, simulation.getPlayer1(), 0.0f, tickRate);
+    input.player2 = autopilot(simulation, simulation.getPlayer2(), Utils::PI, tickRate);
+    return input;
+}
+
+/// <summary>
+/// Runs the simulation without a window as fast as the CPU allows, driven by synthetic input, and prints the achieved tick rate. The match is restarted on game over. With a record file the run is recorded and its final checksum printed, so that a replay can be checked against it.
+/// </summary>
+/// <param name="options">Number of ticks, seed, simulated tick rate, horde size and record file.</param>
+/// <returns>The process exit code; 1 if the recording could not be written.</returns>
+int runHeadless(const HeadlessOptions& options) {
+    Simulation simulation(options.seed, false, options.threads);
+    simulation.setInvulnerable(options.invulnerable);
+    simulation.spawnHorde(options.horde);
+    float dt = 1.0f / options.tickRate;
+
+    ReplayWriter recorder;
+    if (options.recordFile) {
+        ReplayHeader header;
+        header.seed = options.seed;
+        header.tickRate = options.tickRate;
+        header.horde = options.horde;
+        header.invulnerable = options.invulnerable;
+        if (!recorder.open(options.recordFile, header, simulation)) {
+            std::cout << "Aufnahme " << options.recordFile << " kann nicht angelegt werden" << std::endl;
+            return 1;
+        }
+    }
+
+    unsigned long long restarts = 0;
+    size_t maxEnemies = 0;
+    bool restartPending = false;
+
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned long long i = 0; i < options.ticks; i++) {
+        TickInput input = autopilotInput(simulation, options.tickRate);
+        simulation.step(dt, input);
+        if (recorder.isOpen()) {
+            // Der Neustart nach dem vorigen Schritt gehört vor diesen
+            ReplayTick tick;
+            tick.input = input;
+            tick.restart = restartPending;
+            recorder.write(tick, simulation);
+        }
+        maxEnemies = std::max(maxEnemies, simulation.getEnemyCount());
+
+        restartPending = simulation.isGameOver();
+        if (restartPending) {
+            simulation.restart(false);
+            simulation.spawnHorde(options.horde);
+            restarts++;
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    // Bei vollen Pools verworfene Gegner und Schüsse
+    std::size_t dropped = 0;
+    for (std::size_t h = 0; h < 2; h++) {
+        dropped += simulation.getHalf(h).enemies.getDropped() + simulation.getHalf(h).bullets.getDropped();
+    }
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Headless: " << options.ticks << " Ticks in " << seconds << " s ("
+        << static_cast<unsigned long long>(options.ticks / std::max(seconds, 1e-9)) << " Ticks/s), "
+        << restarts << " Neustarts, max. " << maxEnemies << " Gegner";
+    if (dropped > 0) {
+        std::cout << ", " << dropped << " verworfen (Pool voll)";
+    }
+    std::cout << std::endl;
+
+    if (recorder.isOpen()) {
+        if (!recorder.close()) {
+            std::cout << "Aufnahme " << options.recordFile << " unvollständig geschrieben" << std::endl;
+            return 1;
+        }
+        std::cout << "Aufnahme: " << options.recordFile << ", Prüfsumme " << std::hex << stateChecksum(simulation) << std::dec << std::endl;
+    }
+    return 0;
+}
+
+/// <summary>
+/// Replays a recording without a window as fast as the CPU allows and prints the achieved tick rate and the final checksum, which matches the one printed when the recording was made. With a seek tick the replay first jumps there through the closest keyframe and prints how long the jump took; the final checksum is the same either way.
+/// </summary>
+/// <param name="options">The replay file, the tick to start at and the number of threads; everything else comes from the recording.</param>
+/// <returns>The process exit code; 1 if the recording could not be read.</returns>
+int runReplay(const HeadlessOptions& options) {
+    ReplayReader replay;
+    if (!replay.open(options.replayFile)) {
+        std::cout << "Aufnahme " << options.replayFile << " kann nicht gelesen werden" << std::endl;
+        return 1;
+    }
+    const ReplayHeader& header = replay.getHeader();
+    Simulation simulation(header.seed, header.player1UsesController, options.threads);
+    simulation.setInvulnerable(header.invulnerable);
+    simulation.spawnHorde(static_cast<std::size_t>(header.horde));
+
+    if (options.seekTick > 0) {
+        auto seekStart = std::chrono::steady_clock::now();
+        if (!replay.seek(simulation, options.seekTick)) {
+            std::cout << "Aufnahme " << options.replayFile << " hat keinen Index oder ist beschädigt, Sprung nicht möglich" << std::endl;
+            return 1;
+        }
+        double seekSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - seekStart).count();
+        std::cout << "Sprung zu Tick " << replay.getTick() << " in " << seekSeconds * 1000.0 << " ms" << std::endl;
+    }
+
+    unsigned long long ticks = 0;
+    ReplayTick tick;
+    auto start = std::chrono::steady_clock::now();
+    while (replay.read(tick)) {
+        applyReplayTick(simulation, header, tick);
+        ticks++;
+    }
+    auto end = std::chrono::steady_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    std::cout << "Wiedergabe: " << ticks << " Ticks (" << ticks / header.tickRate << " s Spielzeit) in " << seconds << " s ("
+        << static_cast<unsigned long long>(ticks / std::max(seconds, 1e-9)) << " Ticks/s), Prüfsumme "
+        << std::hex << stateChecksum(simulation) << std::dec << std::endl;
+    return 0;
+}
+
+/// <summary>
+/// Plays one side of an online match without a window, at the real-time pace of the tick rate, with synthetic input for the local player. Run it in two processes, one hosting and one joining with the same number of ticks: both print the same checksum at the end if the rollbacks kept them in sync, together with how often and how far they rolled back.
+/// </summary>
+/// <param name="options">The host port or the address to join, the number of ticks and the number of threads; the host also sets seed, tick rate, horde size and rollback window for both.</param>
+/// <returns>The process exit code; 1 if no peer was reached or the peer was lost before the end.</returns>
+int runNetplay(const HeadlessOptions& options) {
+    NetSession net;
+    bool connected = false;
+    if (options.hostPort != 0) {
+        NetSettings settings;
+        settings.seed = options.seed;
+        settings.tickRate = options.tickRate;
+        settings.horde = options.horde;
+        settings.invulnerable = options.invulnerable;
+        settings.rollbackWindow = options.rollbackWindow;
+        std::cout << "Warte auf Mitspieler auf Port " << options.hostPort << " ..." << std::endl;
+        connected = net.host(options.hostPort, settings);
+    }
+    else {
+        std::cout << "Verbinde mit " << options.joinAddress << ":" << options.joinPort << " ..." << std::endl;
+        connected = net.join(sf::IpAddress(options.joinAddress), options.joinPort);
+    }
+    if (!connected) {
+        std::cout << "Kein Mitspieler erreicht" << std::endl;
+        return 1;
+    }
+
+    const NetSettings& settings = net.getSettings();
+    Simulation simulation(settings.seed, false, options.threads);
+    simulation.setInvulnerable(settings.invulnerable);
+    simulation.spawnHorde(static_cast<std::size_t>(settings.horde));
+    std::cout << "Online-Partie als Spieler " << net.getLocalPlayer() + 1 << ", Rollback-Fenster "
+        << settings.rollbackWindow << " Schritte" << std::endl;
+
+    // Bis alle Schritte mit den echten Eingaben beider Spieler simuliert sind
+    const auto tickTime = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(1.0f / settings.tickRate));
+    auto nextTick = std::chrono::steady_clock::now();
+    for (;;) {
+        net.synchronize(simulation);
+        if (net.getConfirmedTick() >= options.ticks || net.isPeerLost()) {
+            break;
+        }
+        if (net.getTick() < options.ticks && net.canAdvance()) {
+            TickInput input = autopilotInput(simulation, settings.tickRate);
+            net.advance(simulation, net.getLocalPlayer() == 0 ? input.player1 : input.player2, simulation.isGameOver());
+        }
+
+        // Nach einem Hänger nicht nachholen. sf::sleep stellt unter Windows
+        // die Timerauflösung auf 1 ms, sonst liefe die Partie mit etwa 64 Hz.
+        nextTick = std::max(nextTick + tickTime, std::chrono::steady_clock::now() - tickTime);
+        auto wait = nextTick - std::chrono::steady_clock::now();
+        sf::sleep(sf::microseconds(std::chrono::duration_cast<std::chrono::microseconds>(wait).count()));
+    }
+
+    // Noch kurz weitersenden, bis der Mitspieler alle eigenen Eingaben hat
+    auto lingerEnd = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (!net.isPeerLost() && net.getPeerAcked() < options.ticks && std::chrono::steady_clock::now() < lingerEnd) {
+        net.synchronize(simulation);
+        sf::sleep(sf::seconds(1.0f / settings.tickRate));
+    }
+
+    net.printStats(std::cout);
+    if (net.getConfirmedTick() < options.ticks) {
+        std::cout << "Mitspieler vor dem Ende getrennt nach " << net.getConfirmedTick() << " Ticks" << std::endl;
+        return 1;
+    }
+    std::cout << "Online-Partie: " << options.ticks << " Ticks, Prüfsumme " << std::hex << stateChecksum(simulation) << std::dec << std::endl;
+    return 0;
+}
\ No newline at end of file
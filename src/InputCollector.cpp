@@ -0,0 +1,108 @@
+#include "../include/InputCollector.h"
+#include "../include/Simulation.h"
+#include <algorithm>
+#include <iostream>
+
+/// <summary>
+/// Constructs a collector that reads the given queue. Only player 1 can use a controller.
+/// </summary>
+/// <param name="queue">The queue filled by the event pump; the collector is its only reader.</param>
+/// <param name="player1UsesController">Indicates whether player 1 starts on the controller.</param>
+InputCollector::InputCollector(InputQueue& queue, bool player1UsesController)
+    : queue(queue), player1UsesController(player1UsesController), onlinePlayer(-1), restarted(false), hasEvents(false) {
+}
+
+/// <summary>
+/// Fills in the movement and aim of a player for this step from the last reported values. An aim point from the mouse becomes a direction from the player's current position.
+/// </summary>
+/// <param name="player">The player the input belongs to.</param>
+/// <param name="input">The last reported movement and aim of the player.</param>
+/// <param name="target">The input for this step that receives movement and aim.</param>
+void InputCollector::applyHeld(const Player& player, const HeldInput& input, PlayerInput& target) const {
+    target.move = input.move;
+    target.aim = input.aimAtPoint ? input.aim - player.getPosition() : input.aim;
+}
+
+/// <summary>
+/// Takes the input events that arrived up to the end of this step from the queue and builds the input of the step. Shoot and throw events become actions of the step; a shot also records how far into the step it was fired, so that its bullet starts as far along as it would have been. Movement and aim are kept until they change again; controller changes and restart requests are applied to the simulation right away, a restart only while the game is over. In an online match the devices of player 1 control the local player, and controller changes and restarts are left to the session, which has to apply them on both peers in the same step; getRestarted then reports the request. Events that arrive later stay in the queue for the next step.
+/// </summary>
+/// <param name="simulation">The simulation the step belongs to.</param>
+/// <param name="dt">The fixed duration of a simulation step, in seconds.</param>
+/// <param name="tickEnd">The wall-clock time at which this step is due.</param>
+/// <returns>The input of both players for the step.</returns>
+TickInput InputCollector::collect(Simulation& simulation, float dt, std::chrono::steady_clock::time_point tickEnd) {
+    TickInput input;
+    restarted = false;
+    hasEvents = false;
+
+    while (const InputEvent* event = queue.front()) {
+        if (event->time > tickEnd) {
+            break;
+        }
+        if (!hasEvents) {
+            hasEvents = true;
+            oldestEvent = event->time;
+        }
+
+        PlayerInput& playerInput = event->player == 0 ? input.player1 : input.player2;
+        HeldInput& playerHeld = held[event->player];
+        switch (event->type) {
+        case InputEvent::Type::Shoot:
+            if (!playerInput.shoot) {
+                // Ältere Ereignisse (Rückstand) zählen ab Schrittbeginn
+                float remaining = std::chrono::duration<float>(tickEnd - event->time).count();
+                playerInput.shoot = true;
+                playerInput.shootDelay = std::max(0.0f, 1.0f - remaining / dt);
+            }
+            break;
+        case InputEvent::Type::Throw:
+            playerInput.throwWeapon = true;
+            break;
+        case InputEvent::Type::Move:
+            playerHeld.move = event->value;
+            break;
+        case InputEvent::Type::Aim:
+        case InputEvent::Type::AimAt:
+            playerHeld.aim = event->value;
+            playerHeld.aimAtPoint = event->type == InputEvent::Type::AimAt;
+            break;
+        case InputEvent::Type::ControllerConnected:
+        case InputEvent::Type::ControllerDisconnected:
+            player1UsesController = event->type == InputEvent::Type::ControllerConnected;
+            if (onlinePlayer < 0) {
+                simulation.getPlayer1().setIsControllerPlayer(player1UsesController);
+            }
+            playerHeld = HeldInput();
+            std::cout << (player1UsesController ? "Controller verbunden!" : "Controller getrennt!") << std::endl;
+            break;
+        case InputEvent::Type::Restart:
+            if (onlinePlayer >= 0) {
+                restarted = true;
+            }
+            else if (simulation.isGameOver()) {
+                simulation.restart(player1UsesController);
+                restarted = true;
+                input = TickInput();
+            }
+            break;
+        case InputEvent::Type::Seek:
+        case InputEvent::Type::Pause:
+            // Steuern nur die Wiedergabe
+            break;
+        }
+        queue.pop();
+    }
+
+    if (onlinePlayer >= 0) {
+        // Den anderen Spieler steuert der Mitspieler
+        PlayerInput local = input.player1;
+        applyHeld(onlinePlayer == 0 ? simulation.getPlayer1() : simulation.getPlayer2(), held[0], local);
+        input = TickInput();
+        (onlinePlayer == 0 ? input.player1 : input.player2) = local;
+        return input;
+    }
+
+    applyHeld(simulation.getPlayer1(), held[0], input.player1);
+    applyHeld(simulation.getPlayer2(), held[1], input.player2);
+    return input;
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "../include/InputPump.h"
+#include <cmath>
+
+using namespace Constants;
+
+/// <summary>
+/// Constructs an event pump for the given window that writes into the given queue. Only player 1 can use a controller, on joystick 0.
+/// </summary>
+/// <param name="window">The window whose events are read; the pump must run on the thread that created it.</param>
+/// <param name="queue">The queue that receives the input events.</param>
+/// <param name="player1UsesController">Indicates whether player 1 starts on the controller.</param>
+InputPump::InputPump(sf::RenderWindow& window, InputQueue& queue, bool player1UsesController)
+    : window(window),
+    queue(queue),
+    usesController{ player1UsesController, false },
+    joystickId{ 0, 0 } {
+}
+
+/// <summary>
+/// Writes an input event into the queue. If the queue is full the event is dropped; the simulation takes all events every step, so this only happens when it is stalled.
+/// </summary>
+/// <param name="type">The kind of event.</param>
+/// <param name="player">The index of the player the event belongs to.</param>
+/// <param name="time">The time the event was detected.</param>
+/// <param name="value">The direction or point carried by movement and aim events.</param>
+/// <returns>true if the event was queued; false if the queue was full.</returns>
+bool InputPump::push(InputEvent::Type type, int player, std::chrono::steady_clock::time_point time, sf::Vector2f value) {
+    InputEvent event;
+    event.type = type;
+    event.player = static_cast<std::uint8_t>(player);
+    event.value = value;
+    event.time = time;
+    return queue.push(event);
+}
+
+/// <summary>
+/// Reads all pending window events and samples the input devices, and turns both into input events. Shooting and throwing with the keyboard or mouse arrive as press events; the controller triggers are polled and turned into events on the rising edge. Movement and aim are sent whenever they change. Called up to INPUT_SAMPLE_RATE times per second, so an event's time is off by at most one sample period.
+/// </summary>
+/// <returns>false if the window was asked to close; otherwise, true.</returns>
+bool InputPump::pump() {
+    bool open = true;
+
+    sf::Event event;
+    while (window.pollEvent(event)) {
+        auto now = std::chrono::steady_clock::now();
+
+        if (event.type == sf::Event::Closed) {
+            open = false;
+        }
+
+        if (event.type == sf::Event::KeyPressed) {
+            // Waffe werfen
+            if (event.key.code == sf::Keyboard::Space && !usesController[0]) {
+                push(InputEvent::Type::Throw, 0, now);
+            }
+            if (event.key.code == sf::Keyboard::Space) {
+                push(InputEvent::Type::Throw, 1, now);
+            }
+
+            // Schießen für Keyboard-Spieler
+            if (event.key.code == sf::Keyboard::E && !usesController[0]) {
+                push(InputEvent::Type::Shoot, 0, now);
+            }
+
+            // Neustart, wirkt nur nach Spielende
+            if (event.key.code == sf::Keyboard::R) {
+                push(InputEvent::Type::Restart, 0, now);
+            }
+
+            // Spulen und Pause, wirken nur in der Wiedergabe
+            if (event.key.code == sf::Keyboard::Left || event.key.code == sf::Keyboard::Right) {
+                float seconds = event.key.code == sf::Keyboard::Left ? -REPLAY_SEEK_SECONDS : REPLAY_SEEK_SECONDS;
+                push(InputEvent::Type::Seek, 0, now, sf::Vector2f(seconds, 0.0f));
+            }
+            if (event.key.code == sf::Keyboard::P) {
+                push(InputEvent::Type::Pause, 0, now);
+            }
+        }
+
+        // Maus-Schießen
+        if (event.type == sf::Event::MouseButtonPressed) {
+            if (event.mouseButton.button == sf::Mouse::Right) {
+                push(InputEvent::Type::Shoot, 1, now);
+            }
+            if (event.mouseButton.button == sf::Mouse::Left && !usesController[0]) {
+                push(InputEvent::Type::Shoot, 0, now);
+            }
+        }
+
+        // Controller Events
+        if (event.type == sf::Event::JoystickConnected && event.joystickConnect.joystickId == joystickId[0]) {
+            usesController[0] = true;
+            devices[0] = DeviceState();
+            push(InputEvent::Type::ControllerConnected, 0, now);
+        }
+        if (event.type == sf::Event::JoystickDisconnected && event.joystickConnect.joystickId == joystickId[0]) {
+            usesController[0] = false;
+            devices[0] = DeviceState();
+            push(InputEvent::Type::ControllerDisconnected, 0, now);
+        }
+    }
+
+    // Geräte abfragen (Controller-Tasten, Bewegung, Zielen)
+    auto now = std::chrono::steady_clock::now();
+    for (int player = 0; player < 2; player++) {
+        sample(player, now);
+    }
+    return open;
+}
+
+/// <summary>
+/// Samples the input devices of a player, the controller if the player uses one and it is connected, otherwise keyboard and mouse.
+/// </summary>
+/// <param name="player">The index of the player.</param>
+/// <param name="time">The time of the sample.</param>
+void InputPump::sample(int player, std::chrono::steady_clock::time_point time) {
+    if (usesController[player] && sf::Joystick::isConnected(joystickId[player])) {
+        sampleController(player, time);
+    }
+    else {
+        sampleKeyboardAndMouse(player, time);
+    }
+}
+
+/// <summary>
+/// Samples the controller of a player: writes an event when a shoot or throw trigger goes from released to pressed, and when the left stick (movement) or right stick (aim) leaves or changes outside the deadzone.
+/// </summary>
+/// <param name="player">The index of the player.</param>
+/// <param name="time">The time of the sample.</param>
+void InputPump::sampleController(int player, std::chrono::steady_clock::time_point time) {
+    unsigned int joystick = joystickId[player];
+    DeviceState& state = devices[player];
+
+    // Schießen und Werfen: Trigger (Z-Achse) oder Schultertasten
+    bool shootPressed = sf::Joystick::getAxisPosition(joystick, sf::Joystick::Z) > TRIGGER_THRESHOLD ||
+        sf::Joystick::isButtonPressed(joystick, 7);
+    if (shootPressed && !state.shootHeld) {
+        push(InputEvent::Type::Shoot, player, time);
+    }
+    state.shootHeld = shootPressed;
+
+    bool throwPressed = sf::Joystick::getAxisPosition(joystick, sf::Joystick::Z) < -TRIGGER_THRESHOLD ||
+        sf::Joystick::isButtonPressed(joystick, 6);
+    if (throwPressed && !state.throwHeld) {
+        push(InputEvent::Type::Throw, player, time);
+    }
+    state.throwHeld = throwPressed;
+
+    // Bewegung mit linkem Stick
+    sf::Vector2f move;
+    float moveX = sf::Joystick::getAxisPosition(joystick, sf::Joystick::X);
+    float moveY = sf::Joystick::getAxisPosition(joystick, sf::Joystick::Y);
+    if (std::abs(moveX) > JOYSTICK_DEADZONE) move.x = moveX / 100.0f;
+    if (std::abs(moveY) > JOYSTICK_DEADZONE) move.y = moveY / 100.0f;
+    if (move != state.move && push(InputEvent::Type::Move, player, time, move)) {
+        state.move = move;
+    }
+
+    // Zielen mit rechtem Stick
+    sf::Vector2f aim;
+    float aimX = sf::Joystick::getAxisPosition(joystick, sf::Joystick::U);
+    float aimY = sf::Joystick::getAxisPosition(joystick, sf::Joystick::V);
+    if (std::abs(aimX) > JOYSTICK_DEADZONE || std::abs(aimY) > JOYSTICK_DEADZONE) {
+        aim = sf::Vector2f(aimX, aimY);
+    }
+    if ((aim != state.aim || state.aimAtPoint) && push(InputEvent::Type::Aim, player, time, aim)) {
+        state.aim = aim;
+        state.aimAtPoint = false;
+    }
+}
+
+/// <summary>
+/// Samples keyboard and mouse for a player: writes an event when the WASD movement direction or the aim point under the mouse cursor changes. Shooting and throwing with keyboard and mouse come from the window events.
+/// </summary>
+/// <param name="player">The index of the player.</param>
+/// <param name="time">The time of the sample.</param>
+void InputPump::sampleKeyboardAndMouse(int player, std::chrono::steady_clock::time_point time) {
+    DeviceState& state = devices[player];
+
+    sf::Vector2f move;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::W)) move.y -= 1;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::S)) move.y += 1;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::A)) move.x -= 1;
+    if (sf::Keyboard::isKeyPressed(sf::Keyboard::D)) move.x += 1;
+    if (move != state.move && push(InputEvent::Type::Move, player, time, move)) {
+        state.move = move;
+    }
+
+    // Zielen mit Maus: der Punkt im Spielfeld, die Richtung bestimmt die
+    // Simulation mit der Spielerposition des Schritts
+    sf::Vector2f aimPoint = window.mapPixelToCoords(sf::Mouse::getPosition(window));
+    if ((aimPoint != state.aim || !state.aimAtPoint) && push(InputEvent::Type::AimAt, player, time, aimPoint)) {
+        state.aim = aimPoint;
+        state.aimAtPoint = true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,164 @@
+#include "../include/JobSystem.h"
+#include <algorithm>
+#include <chrono>
+
+// Läuft der aktuelle Thread als Worker? Verschachtelte parallelFor-Aufrufe
+// laufen dann direkt im Worker.
+static thread_local bool insideWorker = false;
+
+// So lange wartet ein Worker aktiv auf die nächste Aufgabe, bevor er schläft.
+// Simulationsschritte folgen dicht aufeinander, und das Aufwecken über die
+// Condition Variable dauert länger als ein kleiner Block Arbeit.
+static const std::chrono::microseconds WORKER_SPIN_TIME(50);
+
+/// <summary>
+/// Starts the worker threads. The thread calling parallelFor works along, so one thread fewer than requested is started.
+/// </summary>
+/// <param name="threads">The total number of threads, including the calling thread; 0 uses one thread per hardware thread.</param>
+JobSystem::JobSystem(unsigned int threads)
+    : threadCount(threads > 0 ? threads : std::max(1u, std::thread::hardware_concurrency())),
+    queues(new Queue[threadCount]),
+    pending(0),
+    generation(0),
+    stopping(false) {
+    task = Task{ nullptr, nullptr, 0, 1 };
+    workers.reserve(threadCount - 1);
+    for (unsigned int i = 1; i < threadCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+/// <summary>
+/// Stops and joins all worker threads.
+/// </summary>
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/// <summary>
+/// Runs all chunks of a task and returns when they are finished. The chunks are handed out in contiguous ranges, one per thread, and the calling thread works along. A single chunk, a single thread or a call from inside a worker runs the chunks in order on the calling thread.
+/// </summary>
+/// <param name="newTask">The loop body and the index range to split into chunks.</param>
+void JobSystem::run(const Task& newTask) {
+    const std::size_t chunks = chunkCount(newTask.count, newTask.grain);
+    if (chunks <= 1 || threadCount == 1 || insideWorker) {
+        for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+            std::size_t begin = chunk * newTask.grain;
+            newTask.invoke(newTask.function, begin, std::min(begin + newTask.grain, newTask.count), chunk);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> dispatch(dispatchMutex);
+    task = newTask;
+    pending.store(chunks, std::memory_order_relaxed);
+
+    // Blöcke gleichmäßig auf die Threads verteilen
+    for (unsigned int i = 0; i < threadCount; i++) {
+        std::lock_guard<std::mutex> lock(queues[i].mutex);
+        queues[i].first = chunks * i / threadCount;
+        queues[i].last = chunks * (i + 1) / threadCount;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        generation++;
+    }
+    wake.notify_all();
+
+    // Mitarbeiten, dann auf die Blöcke warten, die noch in Arbeit sind
+    insideWorker = true;
+    while (runChunk(0)) {
+    }
+    insideWorker = false;
+    while (pending.load(std::memory_order_acquire) > 0) {
+        std::this_thread::yield();
+    }
+}
+
+/// <summary>
+/// Takes one chunk and runs it: the last chunk of the thread's own range, or else the front half of the largest range of another thread, of which the first chunk is run and the rest kept. Both queues are locked while stealing, so a range handed out at the same time is never overwritten.
+/// </summary>
+/// <param name="self">The index of the calling thread's queue.</param>
+/// <returns>true if a chunk was run; false if no chunks are left.</returns>
+bool JobSystem::runChunk(unsigned int self) {
+    Queue& own = queues[self];
+    std::size_t chunk = 0;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.first < own.last) {
+                chunk = --own.last;
+                break;
+            }
+        }
+
+        // Stehlen: vordere Hälfte des größten fremden Bereichs
+        unsigned int victim = self;
+        std::size_t largest = 0;
+        for (unsigned int i = 0; i < threadCount; i++) {
+            if (i == self) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(queues[i].mutex);
+            if (queues[i].last - queues[i].first > largest) {
+                largest = queues[i].last - queues[i].first;
+                victim = i;
+            }
+        }
+        if (largest == 0) {
+            return false;
+        }
+
+        Queue& other = queues[victim];
+        std::unique_lock<std::mutex> ownLock(own.mutex, std::defer_lock);
+        std::unique_lock<std::mutex> otherLock(other.mutex, std::defer_lock);
+        std::lock(ownLock, otherLock);
+        if (own.first < own.last || other.first >= other.last) {
+            continue; // Inzwischen verändert, neu versuchen
+        }
+        std::size_t take = (other.last - other.first + 1) / 2;
+        chunk = other.first;
+        own.first = chunk + 1;
+        own.last = chunk + take;
+        other.first = chunk + take;
+        break;
+    }
+
+    std::size_t begin = chunk * task.grain;
+    task.invoke(task.function, begin, std::min(begin + task.grain, task.count), chunk);
+    pending.fetch_sub(1, std::memory_order_release);
+    return true;
+}
+
+/// <summary>
+/// The loop of a worker thread: waits until a new task is dispatched, then runs chunks until none are left. A worker spins for a short while before it goes to sleep.
+/// </summary>
+/// <param name="self">The index of the worker's queue.</param>
+void JobSystem::workerLoop(unsigned int self) {
+    insideWorker = true;
+    unsigned long long seen = 0;
+    while (true) {
+        auto spinEnd = std::chrono::steady_clock::now() + WORKER_SPIN_TIME;
+        while (generation.load(std::memory_order_acquire) == seen && !stopping.load(std::memory_order_relaxed) &&
+            std::chrono::steady_clock::now() < spinEnd) {
+            std::this_thread::yield();
+        }
+        {
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+        while (runChunk(self)) {
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "../include/LatencyStats.h"
+#include <algorithm>
+#include <cmath>
+
+/// <summary>
+/// Constructs an empty measurement and allocates room for the given number of samples up front, so that recording never allocates.
+/// </summary>
+/// <param name="capacity">The number of samples kept; once full, the oldest samples are overwritten.</param>
+LatencyStats::LatencyStats(std::size_t capacity)
+    : capacity(std::max<std::size_t>(capacity, 1)), next(0), recorded(0) {
+    samples.reserve(this->capacity);
+}
+
+/// <summary>
+/// Records one latency. Once the buffer is full, the oldest sample is overwritten, so the statistics describe the most recent samples.
+/// </summary>
+/// <param name="latency">The measured latency.</param>
+void LatencyStats::record(std::chrono::steady_clock::duration latency) {
+    float ms = std::chrono::duration<float, std::milli>(latency).count();
+    if (samples.size() < capacity) {
+        samples.push_back(ms);
+    }
+    else {
+        samples[next] = ms;
+    }
+    next = (next + 1) % capacity;
+    recorded++;
+}
+
+/// <summary>
+/// Removes all samples. The buffer keeps its memory.
+/// </summary>
+void LatencyStats::clear() {
+    samples.clear();
+    next = 0;
+    recorded = 0;
+}
+
+/// <summary>
+/// Computes the median, the 90th and 99th percentile and the maximum of the kept samples. Works on a copy, so it allocates; meant for reporting, not for the hot path.
+/// </summary>
+/// <returns>The summary in milliseconds; all zero if nothing was recorded.</returns>
+LatencySummary LatencyStats::summarize() const {
+    LatencySummary summary = { samples.size(), 0.0, 0.0, 0.0, 0.0 };
+    if (samples.empty()) {
+        return summary;
+    }
+
+    // Nächster Rang, ohne Interpolation
+    std::vector<float> sorted(samples);
+    auto percentile = [&](double p) {
+        std::size_t rank = static_cast<std::size_t>(std::ceil(p * sorted.size()));
+        auto nth = sorted.begin() + (std::max<std::size_t>(rank, 1) - 1);
+        std::nth_element(sorted.begin(), nth, sorted.end());
+        return static_cast<double>(*nth);
+    };
+    summary.p50 = percentile(0.50);
+    summary.p90 = percentile(0.90);
+    summary.p99 = percentile(0.99);
+    summary.max = *std::max_element(sorted.begin(), sorted.end());
+    return summary;
+}
+
+/// <summary>
+/// Prints the summary as one readable line.
+/// </summary>
+/// <param name="out">The stream to print to.</param>
+/// <param name="stage">The name of the measuring point, e.g. "Eingabe bis Bild".</param>
+void LatencyStats::print(std::ostream& out, const char* stage) const {
+    LatencySummary summary = summarize();
+    out << stage << ": " << summary.count << " Messwerte, p50 " << summary.p50 << " ms, p90 " << summary.p90
+        << " ms, p99 " << summary.p99 << " ms, max. " << summary.max << " ms" << std::endl;
+}
+
+/// <summary>
+/// Writes the summary as one CSV row matching writeCsvHeader.
+/// </summary>
+/// <param name="out">The stream to write to.</param>
+/// <param name="stage">The name of the measuring point.</param>
+void LatencyStats::writeCsvRow(std::ostream& out, const char* stage) const {
+    LatencySummary summary = summarize();
+    out << stage << ',' << summary.count << ',' << summary.p50 << ',' << summary.p90 << ','
+        << summary.p99 << ',' << summary.max << '\n';
+}
+
+/// <summary>
+/// Writes the header row for writeCsvRow.
+/// </summary>
+/// <param name="out">The stream to write to.</param>
+void LatencyStats::writeCsvHeader(std::ostream& out) {
+    out << "stage,count,p50_ms,p90_ms,p99_ms,max_ms\n";
+}
\ No newline at end of file
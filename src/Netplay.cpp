@@ -0,0 +1,379 @@
+#include "../include/Netplay.h"
+#include "../include/Simulation.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+using namespace Constants;
+
+// Protokollkennung und -version, Teil von Anfrage und Antwort
+static const sf::Uint32 NET_MAGIC = 0x51544E50; // "QTNP"
+static const sf::Uint16 NET_VERSION = 1;
+
+// Pakettypen
+enum PacketType : sf::Uint8 {
+    PACKET_HELLO = 1,   // Mitspieler -> Host: Verbindungsanfrage
+    PACKET_WELCOME = 2, // Host -> Mitspieler: Einstellungen der Partie
+    PACKET_INPUTS = 3,  // Beide: Bestätigung, dann die noch unbestätigten eigenen Eingaben
+};
+
+// Aktions-Byte einer Eingabe
+enum InputFlags : sf::Uint8 {
+    INPUT_SHOOT = 1 << 0,   // folgt: float shootDelay
+    INPUT_THROW = 1 << 1,
+    INPUT_RESTART = 1 << 2,
+};
+
+static const std::uint64_t NO_TICK = std::numeric_limits<std::uint64_t>::max();
+
+/// <summary>
+/// Appends the input of one player for one step to a packet. Floats are copied bit for bit, so both peers simulate with exactly the same values.
+/// </summary>
+/// <param name="packet">The packet to append to.</param>
+/// <param name="input">The input of the player.</param>
+/// <param name="restart">Whether the player asked for a restart in this step.</param>
+static void writeInput(sf::Packet& packet, const PlayerInput& input, bool restart) {
+    sf::Uint8 flags = (input.shoot ? INPUT_SHOOT : 0) | (input.throwWeapon ? INPUT_THROW : 0) | (restart ? INPUT_RESTART : 0);
+    packet << input.move.x << input.move.y << input.aim.x << input.aim.y << flags;
+    if (input.shoot) {
+        packet << input.shootDelay;
+    }
+}
+
+/// <summary>
+/// Reads the input of one player for one step written by writeInput.
+/// </summary>
+/// <param name="packet">The packet to read from.</param>
+/// <param name="input">Receives the input.</param>
+/// <param name="restart">Receives whether the player asked for a restart.</param>
+/// <returns>true if the input was read completely; otherwise, false.</returns>
+static bool readInput(sf::Packet& packet, PlayerInput& input, bool& restart) {
+    sf::Uint8 flags = 0;
+    input = PlayerInput();
+    if (!(packet >> input.move.x >> input.move.y >> input.aim.x >> input.aim.y >> flags)) {
+        return false;
+    }
+    input.shoot = (flags & INPUT_SHOOT) != 0;
+    input.throwWeapon = (flags & INPUT_THROW) != 0;
+    restart = (flags & INPUT_RESTART) != 0;
+    return !input.shoot || (packet >> input.shootDelay);
+}
+
+/// <summary>
+/// Compares two inputs of a player for one step, including the restart request.
+/// </summary>
+/// <returns>true if simulating with either input gives the same result.</returns>
+static bool sameInput(const PlayerInput& a, bool aRestart, const PlayerInput& b, bool bRestart) {
+    return a.move == b.move && a.aim == b.aim && a.shoot == b.shoot && a.throwWeapon == b.throwWeapon &&
+        (!a.shoot || a.shootDelay == b.shootDelay) && aRestart == bRestart;
+}
+
+/// <summary>
+/// Constructs a session that is not connected yet.
+/// </summary>
+NetSession::NetSession()
+    : peerPort(0), connected(false), peerLost(false), localPlayer(0),
+    tick(0), remoteTicks(0), peerAcked(0), firstMispredicted(NO_TICK),
+    rollbacks(0), resimulatedTicks(0), maxRollbackTicks(0), maxRollbackMs(0.0), waits(0) {
+}
+
+/// <summary>
+/// Waits up to NET_CONNECT_TIMEOUT seconds for a peer to join on the given port and sends it the settings of the match. The host plays player 1.
+/// </summary>
+/// <param name="port">The UDP port to listen on.</param>
+/// <param name="hostSettings">The seed and settings of the match.</param>
+/// <returns>true if a peer joined; false if the port could not be opened or nobody joined in time.</returns>
+bool NetSession::host(unsigned short port, const NetSettings& hostSettings) {
+    if (socket.bind(port) != sf::Socket::Done) {
+        return false;
+    }
+    socket.setBlocking(false);
+
+    sf::Clock waiting;
+    while (waiting.getElapsedTime().asSeconds() < NET_CONNECT_TIMEOUT) {
+        sf::Uint8 type = 0;
+        sf::Uint32 magic = 0;
+        sf::Uint16 version = 0;
+        if (socket.receive(incoming, peerAddress, peerPort) == sf::Socket::Done &&
+            (incoming >> type >> magic >> version) && type == PACKET_HELLO && magic == NET_MAGIC && version == NET_VERSION) {
+            start(hostSettings, 0);
+            sendWelcome();
+            return true;
+        }
+        sf::sleep(sf::milliseconds(10));
+    }
+    return false;
+}
+
+/// <summary>
+/// Asks the host at the given address to join its match, repeating the request every NET_HELLO_INTERVAL seconds for up to NET_CONNECT_TIMEOUT seconds, and takes over the settings it sends. The joining peer plays player 2.
+/// </summary>
+/// <param name="address">The address of the host.</param>
+/// <param name="port">The UDP port the host listens on.</param>
+/// <returns>true if the host answered; otherwise, false.</returns>
+bool NetSession::join(const sf::IpAddress& address, unsigned short port) {
+    if (socket.bind(sf::Socket::AnyPort) != sf::Socket::Done) {
+        return false;
+    }
+    socket.setBlocking(false);
+    peerAddress = address;
+    peerPort = port;
+
+    sf::Clock waiting;
+    sf::Time nextHello = sf::Time::Zero;
+    while (waiting.getElapsedTime().asSeconds() < NET_CONNECT_TIMEOUT) {
+        if (waiting.getElapsedTime() >= nextHello) {
+            outgoing.clear();
+            outgoing << static_cast<sf::Uint8>(PACKET_HELLO) << NET_MAGIC << NET_VERSION;
+            socket.send(outgoing, peerAddress, peerPort);
+            nextHello += sf::seconds(NET_HELLO_INTERVAL);
+        }
+
+        sf::IpAddress sender;
+        unsigned short senderPort = 0;
+        sf::Uint8 type = 0, invulnerable = 0;
+        sf::Uint32 magic = 0;
+        sf::Uint16 version = 0;
+        sf::Uint64 horde = 0;
+        NetSettings hostSettings;
+        if (socket.receive(incoming, sender, senderPort) == sf::Socket::Done && sender == peerAddress && senderPort == peerPort &&
+            (incoming >> type >> magic >> version) && type == PACKET_WELCOME && magic == NET_MAGIC && version == NET_VERSION &&
+            (incoming >> hostSettings.seed >> hostSettings.tickRate >> horde >> invulnerable >> hostSettings.rollbackWindow)) {
+            hostSettings.horde = horde;
+            hostSettings.invulnerable = invulnerable != 0;
+            start(hostSettings, 1);
+            return true;
+        }
+        sf::sleep(sf::milliseconds(10));
+    }
+    return false;
+}
+
+/// <summary>
+/// Starts the match once both peers know each other: takes over the settings and allocates the input and state rings, so that the match itself does not allocate. The input ring covers the inputs still to be resent and those the peer may send ahead; the state ring one state per step that may have to be rolled back.
+/// </summary>
+/// <param name="newSettings">The settings of the match.</param>
+/// <param name="player">The index of the local player.</param>
+void NetSession::start(const NetSettings& newSettings, int player) {
+    settings = newSettings;
+    settings.rollbackWindow = std::min(std::max(settings.rollbackWindow, 1u), NET_MAX_ROLLBACK_WINDOW);
+    localPlayer = player;
+    connected = true;
+    peerLost = false;
+
+    inputs.assign(4 * (settings.rollbackWindow + 1), TickInputs());
+    states.resize(settings.rollbackWindow + 1);
+    tick = 0;
+    remoteTicks = 0;
+    peerAcked = 0;
+    firstMispredicted = NO_TICK;
+    sinceReceive.restart();
+}
+
+/// <summary>
+/// Sends the settings of the match to the peer. Repeated whenever the peer asks again, in case the answer got lost.
+/// </summary>
+void NetSession::sendWelcome() {
+    outgoing.clear();
+    outgoing << static_cast<sf::Uint8>(PACKET_WELCOME) << NET_MAGIC << NET_VERSION
+        << settings.seed << settings.tickRate << static_cast<sf::Uint64>(settings.horde)
+        << static_cast<sf::Uint8>(settings.invulnerable ? 1 : 0) << settings.rollbackWindow;
+    socket.send(outgoing, peerAddress, peerPort);
+}
+
+/// <summary>
+/// Reads all packets that arrived from the peer. Packets from other senders are ignored.
+/// </summary>
+void NetSession::receive() {
+    sf::IpAddress sender;
+    unsigned short senderPort = 0;
+    while (socket.receive(incoming, sender, senderPort) == sf::Socket::Done) {
+        if (sender != peerAddress || senderPort != peerPort) {
+            continue;
+        }
+        sinceReceive.restart();
+
+        sf::Uint8 type = 0;
+        incoming >> type;
+        if (type == PACKET_HELLO && localPlayer == 0) {
+            sendWelcome();
+        }
+        else if (type == PACKET_INPUTS) {
+            receiveInputs(incoming);
+        }
+    }
+}
+
+/// <summary>
+/// Takes over the acknowledgement and the inputs of an input packet. Inputs are only taken in order, so every step below remoteTicks has the real input of the peer. An input for a step that was already simulated with a different prediction marks that step for the next rollback.
+/// </summary>
+/// <param name="packet">The packet, read up to the packet type.</param>
+void NetSession::receiveInputs(sf::Packet& packet) {
+    sf::Uint64 ack = 0, first = 0;
+    sf::Uint16 count = 0;
+    if (!(packet >> ack >> first >> count)) {
+        return;
+    }
+    peerAcked = std::max(peerAcked, std::min<std::uint64_t>(ack, tick));
+
+    const int remote = 1 - localPlayer;
+    for (sf::Uint16 i = 0; i < count; i++) {
+        PlayerInput input;
+        bool restart = false;
+        if (!readInput(packet, input, restart)) {
+            return;
+        }
+
+        // Bekanntes überspringen; Lücken und Eingaben jenseits des Rings kann es nur bei fremden Paketen geben
+        std::uint64_t t = first + i;
+        if (t < remoteTicks) {
+            continue;
+        }
+        if (t > remoteTicks || t >= tick + 2 * settings.rollbackWindow) {
+            return;
+        }
+
+        TickInputs& inputsOfTick = slot(t);
+        if (t < tick && !sameInput(inputsOfTick.input[remote], inputsOfTick.restart[remote], input, restart)) {
+            firstMispredicted = std::min(firstMispredicted, t);
+        }
+        inputsOfTick.input[remote] = input;
+        inputsOfTick.restart[remote] = restart;
+        remoteTicks++;
+    }
+}
+
+/// <summary>
+/// Sends the acknowledgement of the peer's inputs and all local inputs the peer has not confirmed yet. Inputs older than twice the rollback window are never needed: the peer cannot be that far behind, or this peer would be waiting for it.
+/// </summary>
+void NetSession::send() {
+    const std::uint64_t window = settings.rollbackWindow;
+    std::uint64_t first = std::max(peerAcked, tick > 2 * window ? tick - 2 * window : 0);
+    std::uint64_t count = std::min<std::uint64_t>(tick - first, NET_MAX_INPUTS_PER_PACKET);
+
+    outgoing.clear();
+    outgoing << static_cast<sf::Uint8>(PACKET_INPUTS) << static_cast<sf::Uint64>(remoteTicks)
+        << static_cast<sf::Uint64>(first) << static_cast<sf::Uint16>(count);
+    for (std::uint64_t t = first; t < first + count; t++) {
+        writeInput(outgoing, slot(t).input[localPlayer], slot(t).restart[localPlayer]);
+    }
+    socket.send(outgoing, peerAddress, peerPort);
+}
+
+/// <summary>
+/// Predicts the input of the peer for a step whose real input has not arrived: movement and aim as in the last known step, no shooting, throwing or restart, because repeating those would be wrong far more often than not.
+/// </summary>
+/// <returns>The predicted input.</returns>
+PlayerInput NetSession::predict() const {
+    PlayerInput prediction;
+    if (remoteTicks > 0) {
+        const PlayerInput& last = inputs[(remoteTicks - 1) % inputs.size()].input[1 - localPlayer];
+        prediction.move = last.move;
+        prediction.aim = last.aim;
+    }
+    return prediction;
+}
+
+/// <summary>
+/// Simulates one step with the inputs known for it, predicting the peer's input if it has not arrived, and keeps the state before the step for a later rollback. A restart request of either player restarts the match before the step if it is over, with the horde of the settings, exactly like a replay does.
+/// </summary>
+/// <param name="simulation">The simulation of the match.</param>
+/// <param name="t">The step to simulate; the simulation must be at the state before it.</param>
+void NetSession::simulate(Simulation& simulation, std::uint64_t t) {
+    simulation.saveState(states[t % states.size()]);
+
+    TickInputs& inputsOfTick = slot(t);
+    const int remote = 1 - localPlayer;
+    if (t >= remoteTicks) {
+        inputsOfTick.input[remote] = predict();
+        inputsOfTick.restart[remote] = false;
+    }
+
+    if ((inputsOfTick.restart[0] || inputsOfTick.restart[1]) && simulation.isGameOver()) {
+        simulation.restart(false);
+        simulation.spawnHorde(static_cast<std::size_t>(settings.horde));
+    }
+    TickInput input;
+    input.player1 = inputsOfTick.input[0];
+    input.player2 = inputsOfTick.input[1];
+    simulation.step(1.0f / settings.tickRate, input);
+}
+
+/// <summary>
+/// Goes back to the state before the earliest mispredicted step and simulates up to the current step again with the inputs known now. At most rollbackWindow steps are simulated again, which bounds the extra work within one frame.
+/// </summary>
+/// <param name="simulation">The simulation of the match.</param>
+void NetSession::rollback(Simulation& simulation) {
+    if (firstMispredicted >= tick) {
+        firstMispredicted = NO_TICK;
+        return;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    simulation.loadState(states[firstMispredicted % states.size()]);
+    for (std::uint64_t t = firstMispredicted; t < tick; t++) {
+        simulate(simulation, t);
+    }
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    rollbacks++;
+    resimulatedTicks += tick - firstMispredicted;
+    maxRollbackTicks = std::max<unsigned long long>(maxRollbackTicks, tick - firstMispredicted);
+    maxRollbackMs = std::max(maxRollbackMs, ms);
+    firstMispredicted = NO_TICK;
+}
+
+/// <summary>
+/// Exchanges inputs with the peer and corrects the simulation if a prediction turned out wrong. Call once per step, also while waiting for the peer; every call sends a packet, which keeps inputs and acknowledgements flowing. After NET_TIMEOUT seconds without a packet the peer counts as lost and the match stops advancing.
+/// </summary>
+/// <param name="simulation">The simulation of the match.</param>
+void NetSession::synchronize(Simulation& simulation) {
+    if (!connected) {
+        return;
+    }
+    receive();
+    if (!peerLost && sinceReceive.getElapsedTime().asSeconds() > NET_TIMEOUT) {
+        peerLost = true;
+        std::cout << "Mitspieler getrennt" << std::endl;
+    }
+    rollback(simulation);
+    if (tick >= remoteTicks + settings.rollbackWindow) {
+        waits++;
+    }
+    send();
+}
+
+/// <summary>
+/// Checks whether the next step may be simulated: the peer is connected and its last known input is less than rollbackWindow steps behind.
+/// </summary>
+/// <returns>true if advance may be called; otherwise, false.</returns>
+bool NetSession::canAdvance() const {
+    return connected && !peerLost && tick < remoteTicks + settings.rollbackWindow;
+}
+
+/// <summary>
+/// Simulates the next step with the given local input and sends the input to the peer right away. Only call when canAdvance returns true.
+/// </summary>
+/// <param name="simulation">The simulation of the match.</param>
+/// <param name="input">The input of the local player for the step.</param>
+/// <param name="restart">Whether the local player asks for a restart.</param>
+void NetSession::advance(Simulation& simulation, const PlayerInput& input, bool restart) {
+    TickInputs& inputsOfTick = slot(tick);
+    inputsOfTick.input[localPlayer] = input;
+    inputsOfTick.restart[localPlayer] = restart;
+    simulate(simulation, tick);
+    tick++;
+    send();
+}
+
+/// <summary>
+/// Prints how often and how far the session rolled back, the longest rollback compared to the duration of a step, and how often it had to wait for the peer.
+/// </summary>
+/// <param name="out">The stream to print to.</param>
+void NetSession::printStats(std::ostream& out) const {
+    out << "Online: " << tick << " Schritte, " << rollbacks << " Rollbacks mit im Schnitt "
+        << (rollbacks > 0 ? static_cast<double>(resimulatedTicks) / rollbacks : 0.0) << " Schritten, max. "
+        << maxRollbackTicks << " Schritte in " << maxRollbackMs << " ms (Schritt: " << 1000.0f / settings.tickRate
+        << " ms), " << waits << " Mal auf den Mitspieler gewartet" << std::endl;
+}
\ No newline at end of file
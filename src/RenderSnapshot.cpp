@@ -0,0 +1,85 @@
+#include "../include/RenderSnapshot.h"
+#include "../include/Simulation.h"
+#include "../include/Constants.h"
+#include <algorithm>
+
+using namespace Constants;
+
+/// <summary>
+/// Constructs an empty snapshot and allocates room for the regular enemy and bullet pools of both halves, so that capturing does not allocate.
+/// </summary>
+RenderSnapshot::RenderSnapshot()
+    : players(), weapon(), health{ 0, 0 }, player1UsesController(false), gameOver(false), tickTime(1.0f / SIM_TICK_RATE), dt(1.0f / SIM_TICK_RATE), sequence(0) {
+    for (std::vector<float>* values : { &enemyX, &enemyY, &enemyVX, &enemyVY }) {
+        values->reserve(2 * ENEMY_POOL_SIZE);
+    }
+    for (std::vector<float>* values : { &bulletX, &bulletY, &bulletVX, &bulletVY }) {
+        values->reserve(2 * BULLET_POOL_SIZE);
+    }
+}
+
+/// <summary>
+/// Appends the values of both halves to one list, replacing its previous content. Keeps the capacity of the list.
+/// </summary>
+/// <param name="target">The list that receives the values.</param>
+/// <param name="left">The values of the left half.</param>
+/// <param name="right">The values of the right half.</param>
+static void concatenate(std::vector<float>& target, const std::vector<float>& left, const std::vector<float>& right) {
+    target.assign(left.begin(), left.end());
+    target.insert(target.end(), right.begin(), right.end());
+}
+
+/// <summary>
+/// Copies the state needed for drawing from the simulation.
+/// </summary>
+/// <param name="simulation">The simulation after its latest step.</param>
+/// <param name="dueTime">The wall-clock time at which the latest step was due, used to interpolate toward the next one.</param>
+/// <param name="tickSeconds">The wall-clock time between two simulation steps, in seconds.</param>
+/// <param name="stepSeconds">The simulated duration of a step, in seconds, used to move enemies and bullets back along their velocities.</param>
+void RenderSnapshot::capture(const Simulation& simulation, std::chrono::steady_clock::time_point dueTime, float tickSeconds, float stepSeconds) {
+    const Player* sources[2] = { &simulation.getPlayer1(), &simulation.getPlayer2() };
+    for (int i = 0; i < 2; i++) {
+        players[i].previousPosition = sources[i]->getPreviousPosition();
+        players[i].position = sources[i]->getPosition();
+        players[i].previousRotation = sources[i]->getPreviousRotation();
+        players[i].rotation = sources[i]->getRotation();
+        health[i] = sources[i]->getHealth();
+    }
+
+    const Weapon& source = simulation.getWeapon();
+    weapon.previousPosition = source.getPreviousPosition();
+    weapon.position = source.getPosition();
+    weapon.previousRotation = source.getPreviousRotation();
+    weapon.rotation = source.getRotation();
+
+    player1UsesController = simulation.getPlayer1().getIsControllerPlayer();
+    gameOver = simulation.isGameOver();
+
+    const ArenaHalf& left = simulation.getHalf(0);
+    const ArenaHalf& right = simulation.getHalf(1);
+    concatenate(enemyX, left.enemies.x, right.enemies.x);
+    concatenate(enemyY, left.enemies.y, right.enemies.y);
+    concatenate(enemyVX, left.enemies.vx, right.enemies.vx);
+    concatenate(enemyVY, left.enemies.vy, right.enemies.vy);
+    concatenate(bulletX, left.bullets.x, right.bullets.x);
+    concatenate(bulletY, left.bullets.y, right.bullets.y);
+    concatenate(bulletVX, left.bullets.vx, right.bullets.vx);
+    concatenate(bulletVY, left.bullets.vy, right.bullets.vy);
+
+    stepTime = dueTime;
+    tickTime = tickSeconds;
+    dt = stepSeconds;
+}
+
+/// <summary>
+/// Returns how far the wall clock has advanced from the latest step toward the next one. After game over everything stands still.
+/// </summary>
+/// <param name="now">The current wall-clock time.</param>
+/// <returns>The fraction of a simulation step, in [0, 1].</returns>
+float RenderSnapshot::getAlpha(std::chrono::steady_clock::time_point now) const {
+    if (gameOver) {
+        return 1.0f;
+    }
+    float elapsed = std::chrono::duration<float>(now - stepTime).count();
+    return std::min(std::max(elapsed / tickTime, 0.0f), 1.0f);
+}
\ No newline at end of file
@@ -0,0 +1,385 @@
+#include "../include/Renderer.h"
+#include "../include/Simulation.h"
+#include "../include/Constants.h"
+#include "../include/Vector2Utils.h"
+#include <cmath>
+#include <iostream>
+#include <string>
+
+using namespace Constants;
+
+// Dreiecke pro Kreis beim gebündelten Zeichnen von Gegnern und Kugeln
+static const int CIRCLE_SEGMENTS = 16;
+
+/// <summary>
+/// Appends one filled circle per entity to a triangle vertex array. Entities are drawn at their position moved back along their velocity by the given time, which yields the interpolated position between two simulation steps.
+/// </summary>
+/// <param name="vertices">The vertex array that receives the triangles.</param>
+/// <param name="x">The x-coordinates of the entities.</param>
+/// <param name="y">The y-coordinates of the entities.</param>
+/// <param name="vx">The x-velocities of the entities.</param>
+/// <param name="vy">The y-velocities of the entities.</param>
+/// <param name="rewind">How far to move back along the velocity, in seconds.</param>
+/// <param name="radius">The radius of the circles.</param>
+/// <param name="color">The fill color of the circles.</param>
+static void appendCircles(sf::VertexArray& vertices, const std::vector<float>& x, const std::vector<float>& y,
+    const std::vector<float>& vx, const std::vector<float>& vy, float rewind, float radius, sf::Color color) {
+    // Einheitskreis nur einmal berechnen
+    static sf::Vector2f unitCircle[CIRCLE_SEGMENTS + 1];
+    static bool unitCircleReady = false;
+    if (!unitCircleReady) {
+        for (int k = 0; k <= CIRCLE_SEGMENTS; k++) {
+            float angle = 2.0f * Utils::PI * k / CIRCLE_SEGMENTS;
+            unitCircle[k] = sf::Vector2f(std::cos(angle), std::sin(angle));
+        }
+        unitCircleReady = true;
+    }
+
+    for (std::size_t i = 0; i < x.size(); i++) {
+        sf::Vector2f center(x[i] - vx[i] * rewind, y[i] - vy[i] * rewind);
+        for (int k = 0; k < CIRCLE_SEGMENTS; k++) {
+            vertices.append(sf::Vertex(center, color));
+            vertices.append(sf::Vertex(center + unitCircle[k] * radius, color));
+            vertices.append(sf::Vertex(center + unitCircle[k + 1] * radius, color));
+        }
+    }
+}
+
+/// <summary>
+/// Constructs the renderer for the given window and sets up all shapes and user interface elements. Drawing starts with start().
+/// </summary>
+/// <param name="window">The window to draw into; its events stay with the thread that created it.</param>
+Renderer::Renderer(sf::RenderWindow& window)
+    : window(window),
+    running(false),
+    publishedSequence(0),
+    shownSequence(0),
+    frameArena(FRAME_ARENA_SIZE),
+    shownHealth1(-1),
+    shownHealth2(-1),
+    shownControls(-1),
+    fontLoaded(false) {
+
+    // Gegner und Kugeln werden gebündelt gezeichnet
+    enemyVertices.setPrimitiveType(sf::Triangles);
+    bulletVertices.setPrimitiveType(sf::Triangles);
+
+    // Mittellinie
+    divider.setSize(sf::Vector2f(8, static_cast<float>(WINDOW_HEIGHT)));
+    divider.setPosition(WINDOW_WIDTH / 2.0f - 4, 0);
+    divider.setFillColor(sf::Color(170, 170, 170));
+
+    // Spieler-Form (Dreieck für bessere Richtungsanzeige)
+    playerShape.setRadius(PLAYER_RADIUS);
+    playerShape.setPointCount(3);
+    playerShape.setFillColor(sf::Color::Black);
+    playerShape.setOrigin(PLAYER_RADIUS, PLAYER_RADIUS);
+
+    // Richtungsindikator
+    directionIndicator.setSize(sf::Vector2f(30, 4));
+    directionIndicator.setFillColor(sf::Color::Black);
+    directionIndicator.setOrigin(0, 2);
+
+    // Waffe
+    weaponShape.setSize(sf::Vector2f(30, 10));
+    weaponShape.setFillColor(sf::Color::Black);
+    weaponShape.setOrigin(15, 5);
+
+    // UI initialisieren
+    initializeUI();
+}
+
+/// <summary>
+/// Stops the render thread if it is still running.
+/// </summary>
+Renderer::~Renderer() {
+    stop();
+}
+
+/// <summary>
+/// Initializes the user interface elements for the game, including fonts, health displays, control instructions, game over text, and health bars for both players.
+/// </summary>
+void Renderer::initializeUI() {
+    // Font laden
+    fontLoaded = font.loadFromFile("C:/Windows/Fonts/arial.ttf");
+
+    if (fontLoaded) {
+        // Health-Texte
+        healthText1.setFont(font);
+        healthText1.setCharacterSize(24);
+        healthText1.setPosition(10, 10);
+        healthText1.setFillColor(sf::Color::Black);
+
+        healthText2.setFont(font);
+        healthText2.setCharacterSize(24);
+        healthText2.setPosition(static_cast<float>(WINDOW_WIDTH - 150), 10);
+        healthText2.setFillColor(sf::Color::Black);
+
+        // Controls-Text
+        controlsText.setFont(font);
+        controlsText.setCharacterSize(16);
+        controlsText.setPosition(10, WINDOW_HEIGHT - 80.0f);
+        controlsText.setFillColor(sf::Color(60, 60, 60));
+
+        // Game Over Text
+        gameOverText.setFont(font);
+        gameOverText.setCharacterSize(48);
+        gameOverText.setFillColor(sf::Color(105, 24, 27));
+        gameOverText.setString("GAME OVER!");
+        sf::FloatRect textBounds = gameOverText.getLocalBounds();
+        gameOverText.setOrigin(textBounds.width / 2, textBounds.height / 2);
+        gameOverText.setPosition(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f);
+
+        // Restart-Hinweis
+        restartText.setFont(font);
+        restartText.setCharacterSize(24);
+        restartText.setFillColor(sf::Color::Black);
+        restartText.setString("Press R to Restart");
+        sf::FloatRect restartBounds = restartText.getLocalBounds();
+        restartText.setOrigin(restartBounds.width / 2, restartBounds.height / 2);
+        restartText.setPosition(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f + 60);
+    }
+
+    // Lebensbalken
+    for (int i = 0; i < PLAYER_MAX_HEALTH; i++) {
+        sf::RectangleShape bar(sf::Vector2f(30, 10));
+        bar.setFillColor(sf::Color::Black);
+        bar.setPosition(10 + i * 35.0f, 40);
+        healthBars1.push_back(bar);
+
+        sf::RectangleShape bar2(sf::Vector2f(30, 10));
+        bar2.setFillColor(sf::Color::Black);
+        bar2.setPosition(WINDOW_WIDTH - 110.0f + i * 35.0f, 40);
+        healthBars2.push_back(bar2);
+    }
+}
+
+/// <summary>
+/// Updates the on-screen text displaying the game controls for each player. The text is assembled in the frame arena.
+/// </summary>
+/// <param name="player1UsesController">Indicates whether player 1 is controlled by a controller.</param>
+void Renderer::updateControlsText(bool player1UsesController) {
+    std::pmr::string controls("P1 (Left): ", frameArena.get());
+    if (player1UsesController) {
+        controls += "Controller - Sticks: Bewegen/Zielen, RT: Schießen, LT: Werfen";
+    }
+    else {
+        controls += "WASD: Bewegen, Maus: Zielen, E: Schießen, Space: Werfen";
+    }
+    controls += "\nP2 (Right): Pfeiltasten: Bewegen, Maus: Zielen, RMB: Schießen, RCtrl: Werfen";
+    controls += "\nR: Neustart";
+
+    if (fontLoaded) {
+        controlsText.setString(controls.c_str());
+    }
+}
+
+/// <summary>
+/// Sets a health text if the health differs from the value it currently shows. The string is assembled in the frame arena.
+/// </summary>
+/// <param name="text">The text to update.</param>
+/// <param name="label">The label in front of the number.</param>
+/// <param name="health">The current health.</param>
+/// <param name="shownHealth">The health the text currently shows; updated when the text is set.</param>
+void Renderer::updateHealthText(sf::Text& text, const char* label, int health, int& shownHealth) {
+    if (health == shownHealth) {
+        return;
+    }
+    shownHealth = health;
+
+    std::pmr::string value(label, frameArena.get());
+    value += std::to_string(health).c_str();
+    text.setString(value.c_str());
+}
+
+/// <summary>
+/// Notes an input that the simulation applied since the last snapshot, so that the next snapshot carries it to the render thread for the latency measurement. Called by the simulation thread.
+/// </summary>
+/// <param name="captureTime">The time the input was captured.</param>
+void Renderer::addInput(std::chrono::steady_clock::time_point captureTime) {
+    pendingInput.include(captureTime);
+}
+
+/// <summary>
+/// Copies the state needed for drawing from the simulation and hands it to the render thread. Called by the simulation thread after its steps; never waits for the render thread. The snapshot also carries the oldest input since the previous snapshot, and the oldest input since the last snapshot known to be read, because the render thread may skip snapshots.
+/// </summary>
+/// <param name="simulation">The simulation after its latest step.</param>
+/// <param name="dueTime">The wall-clock time at which the latest step was due.</param>
+/// <param name="tickTime">The wall-clock time between two simulation steps, in seconds.</param>
+/// <param name="dt">The simulated duration of a step, in seconds; differs from tickTime when a replay runs faster or slower than real time.</param>
+void Renderer::publish(const Simulation& simulation, std::chrono::steady_clock::time_point dueTime, float tickTime, float dt) {
+    RenderSnapshot& snapshot = snapshots.getBack();
+    snapshot.capture(simulation, dueTime, tickTime, dt);
+
+    InputStamp input = pendingInput;
+    pendingInput = InputStamp();
+    unconfirmedInput.include(input);
+    snapshot.sequence = ++publishedSequence;
+    snapshot.input = input;
+    snapshot.unshownInput = unconfirmedInput;
+
+    // Wurde der verdrängte Stand gelesen, sind alle Eingaben bis zu ihm beim
+    // Render-Thread angekommen
+    if (snapshots.publish()) {
+        unconfirmedInput = input;
+    }
+}
+
+/// <summary>
+/// Starts the render thread. The window's drawing context moves to that thread.
+/// </summary>
+void Renderer::start() {
+    if (running) {
+        return;
+    }
+    window.setActive(false);
+    running = true;
+    thread = std::thread(&Renderer::renderLoop, this);
+}
+
+/// <summary>
+/// Stops the render thread and waits for it to finish its current frame. Must be called before the window is closed.
+/// </summary>
+void Renderer::stop() {
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+/// <summary>
+/// The loop of the render thread: takes the newest snapshot, draws it blended toward the next step by the time elapsed since the step was due, and presents the frame. The frame rate limit of the window paces the loop. With QT_COUNT_ALLOCATIONS it reports frames that used the global heap instead of the frame arena.
+/// </summary>
+void Renderer::renderLoop() {
+#ifdef QT_COUNT_ALLOCATIONS
+    unsigned long long frames = 0, allocatingFrames = 0;
+#endif
+
+    window.setActive(true);
+    while (running) {
+        // Kurzlebige Daten des letzten Frames freigeben
+        frameArena.reset();
+#ifdef QT_COUNT_ALLOCATIONS
+        std::size_t allocationsBefore = Memory::getThreadAllocationCount();
+#endif
+
+        bool fresh = snapshots.acquire();
+        const RenderSnapshot& snapshot = snapshots.getFront();
+        render(snapshot, snapshot.getAlpha(std::chrono::steady_clock::now()));
+        if (fresh) {
+            recordDisplayLatency(snapshot);
+        }
+
+#ifdef QT_COUNT_ALLOCATIONS
+        // Debug: im eingeschwungenen Zustand darf kein Frame den Heap benutzen
+        std::size_t allocations = Memory::getThreadAllocationCount() - allocationsBefore;
+        frames++;
+        if (allocations > 0 && allocatingFrames++ == 0) {
+            std::cout << "Debug: Frame " << frames << " hat " << allocations << " globale Allokationen" << std::endl;
+        }
+#endif
+    }
+    window.setActive(false);
+
+#ifdef QT_COUNT_ALLOCATIONS
+    std::cout << "Debug: " << allocatingFrames << " von " << frames << " Frames mit globalen Allokationen" << std::endl;
+#endif
+}
+
+/// <summary>
+/// Records the latency of the oldest input that a snapshot shows for the first time, measured up to the end of the frame that presented it. If snapshots were skipped since the last one shown, their inputs appear in this frame as well.
+/// </summary>
+/// <param name="snapshot">The snapshot that was just presented for the first time.</param>
+void Renderer::recordDisplayLatency(const RenderSnapshot& snapshot) {
+    const InputStamp& input = snapshot.sequence == shownSequence + 1 ? snapshot.input : snapshot.unshownInput;
+    if (input.valid) {
+        displayLatency.record(std::chrono::steady_clock::now() - input.time);
+    }
+    shownSequence = snapshot.sequence;
+}
+
+/// <summary>
+/// Draws a player and its direction indicator, blended between the previous and the current simulation step.
+/// </summary>
+/// <param name="player">The player's state from the snapshot.</param>
+/// <param name="alpha">Blend factor between the previous (0) and the current (1) simulation step.</param>
+void Renderer::drawPlayer(const BodyView& player, float alpha) {
+    sf::Vector2f drawPosition = Utils::lerp(player.previousPosition, player.position, alpha);
+    float drawRotation = Utils::lerpAngle(player.previousRotation, player.rotation, alpha);
+
+    playerShape.setPosition(drawPosition);
+    directionIndicator.setPosition(drawPosition);
+
+    // Rotation anwenden
+    playerShape.setRotation(drawRotation + 90); // +90 weil das Dreieck nach oben zeigt
+    directionIndicator.setRotation(drawRotation);
+
+    window.draw(playerShape);
+    window.draw(directionIndicator);
+}
+
+/// <summary>
+/// Renders all game elements and the user interface of a snapshot to the game window. Entities are drawn blended between the previous and the current simulation step so that motion stays smooth when the render rate is not a multiple of the tick rate.
+/// </summary>
+/// <param name="snapshot">The state to draw.</param>
+/// <param name="alpha">Fraction of a simulation step that has elapsed since the last step, in [0, 1].</param>
+void Renderer::render(const RenderSnapshot& snapshot, float alpha) {
+    // UI nur bei Änderungen neu setzen
+    if (fontLoaded) {
+        updateHealthText(healthText1, "P1 Health: ", snapshot.health[0], shownHealth1);
+        updateHealthText(healthText2, "P2 Health: ", snapshot.health[1], shownHealth2);
+    }
+    if (shownControls != static_cast<int>(snapshot.player1UsesController)) {
+        shownControls = snapshot.player1UsesController;
+        updateControlsText(snapshot.player1UsesController);
+    }
+
+    window.clear(sf::Color::White);
+
+    // Mittellinie
+    window.draw(divider);
+
+    // Spieler
+    drawPlayer(snapshot.players[0], alpha);
+    drawPlayer(snapshot.players[1], alpha);
+
+    // Waffe
+    weaponShape.setPosition(Utils::lerp(snapshot.weapon.previousPosition, snapshot.weapon.position, alpha));
+    weaponShape.setRotation(Utils::lerpAngle(snapshot.weapon.previousRotation, snapshot.weapon.rotation, alpha));
+    window.draw(weaponShape);
+
+    // Gegner und Kugeln: vom aktuellen Schritt entlang der Geschwindigkeit
+    // zurückrechnen, um den Rest des simulierten Schritts
+    float rewind = (1.0f - alpha) * snapshot.dt;
+
+    enemyVertices.clear();
+    bulletVertices.clear();
+    appendCircles(enemyVertices, snapshot.enemyX, snapshot.enemyY, snapshot.enemyVX, snapshot.enemyVY, rewind,
+        ENEMY_RADIUS, sf::Color(170, 170, 170));
+    appendCircles(bulletVertices, snapshot.bulletX, snapshot.bulletY, snapshot.bulletVX, snapshot.bulletVY, rewind,
+        BULLET_RADIUS, sf::Color::Black);
+    window.draw(enemyVertices);
+    window.draw(bulletVertices);
+
+    // UI
+    if (fontLoaded) {
+        window.draw(healthText1);
+        window.draw(healthText2);
+        window.draw(controlsText);
+
+        if (snapshot.gameOver) {
+            window.draw(gameOverText);
+            window.draw(restartText);
+        }
+    }
+
+    // Lebensbalken
+    for (int i = 0; i < snapshot.health[0]; i++) {
+        window.draw(healthBars1[i]);
+    }
+    for (int i = 0; i < snapshot.health[1]; i++) {
+        window.draw(healthBars2[i]);
+    }
+
+    window.display();
+}
\ No newline at end of file
@@ -0,0 +1,447 @@
+#include "../include/Replay.h"
+#include "../include/Simulation.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+// Dateikennung und Formatversion; Version 1 hat weder Keyframes noch Index,
+// die Keyframes von Version 2 lassen sich nur überspringen
+static const char REPLAY_MAGIC[4] = { 'Q', 'T', 'R', 'P' };
+static const std::uint16_t REPLAY_VERSION = 3;
+static const std::uint16_t REPLAY_SEEKABLE_VERSION = 3; // Erste Version mit ladbaren Keyframes
+
+// Abschluss des Index: Schritte gesamt (u64), Beginn des Index (u64),
+// Anzahl Einträge (u32), Kennung
+static const char INDEX_MAGIC[4] = { 'Q', 'T', 'I', 'X' };
+static const std::uint64_t INDEX_FOOTER_SIZE = 8 + 8 + 4 + sizeof(INDEX_MAGIC);
+static const std::uint64_t INDEX_ENTRY_SIZE = 8 + 8;
+
+// Flag-Byte je Schritt; Spieler 2 nutzt die Bits von Spieler 1 um PLAYER_SHIFT verschoben
+enum ReplayFlags : std::uint8_t {
+    FLAG_MOVE = 1 << 0,       // Bewegung geändert, folgt: 2 float
+    FLAG_AIM = 1 << 1,        // Zielrichtung geändert, folgt: 2 float
+    FLAG_ACTION = 1 << 2,     // Schuss oder Wurf, folgt: Aktions-Byte (+ float bei Schuss)
+    FLAG_RESTART = 1 << 6,
+    FLAG_CONTROLLER = 1 << 7, // Steuerung von Spieler 1 gewechselt
+};
+static const int PLAYER_SHIFT = 3;
+
+// Aktions-Byte
+enum ReplayActions : std::uint8_t {
+    ACTION_SHOOT = 1 << 0,
+    ACTION_THROW = 1 << 1,
+};
+
+/// <summary>
+/// Constructs a writer without an open file.
+/// </summary>
+ReplayWriter::ReplayWriter() : keyframeInterval(0), ticks(0) {
+}
+
+/// <summary>
+/// Creates the recording file and writes the header, followed by the first keyframe with the state the match starts from. An existing file is replaced.
+/// </summary>
+/// <param name="path">The path of the recording file.</param>
+/// <param name="header">The seed and settings of the match.</param>
+/// <param name="simulation">The simulation about to be recorded, before its first step.</param>
+/// <returns>true if the file could be created; otherwise, false.</returns>
+bool ReplayWriter::open(const char* path, const ReplayHeader& header, const Simulation& simulation) {
+    out.open(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return false;
+    }
+    last = ReplayTick();
+    last.player1UsesController = header.player1UsesController;
+    keyframeInterval = header.keyframeInterval;
+    ticks = 0;
+    index.clear();
+
+    out.write(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    put(REPLAY_VERSION);
+    put(header.seed);
+    put(header.tickRate);
+    put(header.horde);
+    put(static_cast<std::uint8_t>((header.invulnerable ? 1 : 0) | (header.player1UsesController ? 2 : 0)));
+    put(keyframeInterval);
+    if (keyframeInterval > 0) {
+        writeKeyframe(simulation);
+    }
+    return static_cast<bool>(out);
+}
+
+/// <summary>
+/// Writes a keyframe with the complete state of the simulation and adds it to the index. The state is written as the flat block from Simulation::saveState, preceded by its size, so that a reader can skip it. The steps after a keyframe are written as if they were the first, so that reading can start right behind it.
+/// </summary>
+/// <param name="simulation">The simulation after the last written step.</param>
+void ReplayWriter::writeKeyframe(const Simulation& simulation) {
+    ReplayKeyframe keyframe;
+    keyframe.tick = ticks;
+    keyframe.offset = static_cast<std::uint64_t>(out.tellp());
+    index.push_back(keyframe);
+
+    simulation.saveState(keyframeState);
+    put(ticks);
+    put(static_cast<std::uint8_t>(last.player1UsesController ? 1 : 0));
+    put(static_cast<std::uint32_t>(keyframeState.size()));
+    out.write(reinterpret_cast<const char*>(keyframeState.data()), keyframeState.size());
+
+    bool player1UsesController = last.player1UsesController;
+    last = ReplayTick();
+    last.player1UsesController = player1UsesController;
+}
+
+/// <summary>
+/// Appends one simulation step, followed by a keyframe every keyframeInterval steps. Movement and aim are only written when they differ from the previous step; shooting and throwing are written for the step they happen in.
+/// </summary>
+/// <param name="tick">The input of the step, exactly as it was passed to the simulation.</param>
+/// <param name="simulation">The simulation after the step, for the keyframe.</param>
+void ReplayWriter::write(const ReplayTick& tick, const Simulation& simulation) {
+    const PlayerInput* players[2] = { &tick.input.player1, &tick.input.player2 };
+    const PlayerInput* lastPlayers[2] = { &last.input.player1, &last.input.player2 };
+
+    std::uint8_t flags = 0;
+    for (int p = 0; p < 2; p++) {
+        std::uint8_t playerFlags = 0;
+        if (players[p]->move != lastPlayers[p]->move) playerFlags |= FLAG_MOVE;
+        if (players[p]->aim != lastPlayers[p]->aim) playerFlags |= FLAG_AIM;
+        if (players[p]->shoot || players[p]->throwWeapon) playerFlags |= FLAG_ACTION;
+        flags |= playerFlags << (p * PLAYER_SHIFT);
+    }
+    if (tick.restart) flags |= FLAG_RESTART;
+    if (tick.player1UsesController != last.player1UsesController) flags |= FLAG_CONTROLLER;
+    put(flags);
+
+    for (int p = 0; p < 2; p++) {
+        std::uint8_t playerFlags = flags >> (p * PLAYER_SHIFT);
+        const PlayerInput& input = *players[p];
+        if (playerFlags & FLAG_MOVE) {
+            put(input.move.x);
+            put(input.move.y);
+        }
+        if (playerFlags & FLAG_AIM) {
+            put(input.aim.x);
+            put(input.aim.y);
+        }
+        if (playerFlags & FLAG_ACTION) {
+            put(static_cast<std::uint8_t>((input.shoot ? ACTION_SHOOT : 0) | (input.throwWeapon ? ACTION_THROW : 0)));
+            if (input.shoot) {
+                put(input.shootDelay);
+            }
+        }
+    }
+    last = tick;
+
+    ticks++;
+    if (keyframeInterval > 0 && ticks % keyframeInterval == 0) {
+        writeKeyframe(simulation);
+    }
+}
+
+/// <summary>
+/// Writes the index of the keyframes and closes the recording file. A recording that is not closed, e.g. after a crash, can still be replayed from the start, but not seeked.
+/// </summary>
+/// <returns>true if everything was written; false if writing failed at some point.</returns>
+bool ReplayWriter::close() {
+    std::uint64_t indexStart = static_cast<std::uint64_t>(out.tellp());
+    for (const ReplayKeyframe& keyframe : index) {
+        put(keyframe.tick);
+        put(keyframe.offset);
+    }
+    put(ticks);
+    put(indexStart);
+    put(static_cast<std::uint32_t>(index.size()));
+    out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+
+    out.close();
+    return !out.fail();
+}
+
+/// <summary>
+/// Constructs a reader without an open file.
+/// </summary>
+ReplayReader::ReplayReader()
+    : position(0), dataEnd(0), ticksRead(0), totalTicks(0), keyframePending(false) {
+}
+
+/// <summary>
+/// Opens a recording and reads its header and, if the recording was closed properly, the index of its keyframes. Recordings of versions 1 and 2 are read as well, but only from the start: version 1 has no keyframes, and the keyframes of version 2 hold a layout of the game state that can no longer be restored.
+/// </summary>
+/// <param name="path">The path of the recording file.</param>
+/// <returns>true if the file is a recording in a supported version; otherwise, false.</returns>
+bool ReplayReader::open(const char* path) {
+    in.open(path, std::ios::binary);
+    position = 0;
+    char magic[sizeof(REPLAY_MAGIC)];
+    std::uint16_t version = 0;
+    std::uint8_t settings = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, REPLAY_MAGIC, sizeof(magic)) != 0 ||
+        !get(version) || version < 1 || version > REPLAY_VERSION ||
+        !get(header.seed) || !get(header.tickRate) || !get(header.horde) || !get(settings)) {
+        in.close();
+        return false;
+    }
+    position += sizeof(magic);
+    header.invulnerable = (settings & 1) != 0;
+    header.player1UsesController = (settings & 2) != 0;
+    header.keyframeInterval = 0;
+    if (version >= 2 && !get(header.keyframeInterval)) {
+        in.close();
+        return false;
+    }
+
+    // Index vom Dateiende lesen, danach zurück zum ersten Schritt. Ohne
+    // ladbare Keyframes kein Index, die Aufnahme gilt dann als nicht spulbar.
+    const std::uint64_t dataStart = position;
+    if (version < REPLAY_SEEKABLE_VERSION || !readIndex()) {
+        index.clear();
+        dataEnd = std::numeric_limits<std::uint64_t>::max();
+        totalTicks = 0;
+    }
+    position = dataStart;
+    in.clear();
+    in.seekg(static_cast<std::streamoff>(position));
+
+    last = ReplayTick();
+    last.player1UsesController = header.player1UsesController;
+    ticksRead = 0;
+    keyframePending = header.keyframeInterval > 0;
+    return true;
+}
+
+/// <summary>
+/// Reads the index at the end of the recording, if there is a complete one.
+/// </summary>
+/// <returns>true if the index was read; false if the recording has none, e.g. because it was not closed.</returns>
+bool ReplayReader::readIndex() {
+    in.seekg(0, std::ios::end);
+    const std::uint64_t fileSize = static_cast<std::uint64_t>(in.tellg());
+    if (fileSize < position + INDEX_FOOTER_SIZE) {
+        return false;
+    }
+
+    std::uint64_t indexStart = 0;
+    std::uint32_t count = 0;
+    char magic[sizeof(INDEX_MAGIC)];
+    in.seekg(static_cast<std::streamoff>(fileSize - INDEX_FOOTER_SIZE));
+    if (!get(totalTicks) || !get(indexStart) || !get(count) || !in.read(magic, sizeof(magic)) ||
+        std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0 ||
+        indexStart + count * INDEX_ENTRY_SIZE + INDEX_FOOTER_SIZE != fileSize) {
+        return false;
+    }
+
+    index.resize(count);
+    in.seekg(static_cast<std::streamoff>(indexStart));
+    for (ReplayKeyframe& keyframe : index) {
+        if (!get(keyframe.tick) || !get(keyframe.offset)) {
+            return false;
+        }
+    }
+    dataEnd = indexStart;
+    return count > 0;
+}
+
+/// <summary>
+/// Skips the keyframe in front of the next step. Reading on from there starts over without previous values, like the writer did.
+/// </summary>
+/// <returns>true if the keyframe was skipped; false at the end of the recording or if it is cut off.</returns>
+bool ReplayReader::skipKeyframe() {
+    std::uint64_t tick = 0;
+    std::uint8_t player1UsesController = 0;
+    std::uint32_t size = 0;
+    if (position >= dataEnd || !get(tick) || !get(player1UsesController) || !get(size)) {
+        return false;
+    }
+    position += size;
+    in.seekg(size, std::ios::cur);
+
+    last = ReplayTick();
+    last.player1UsesController = player1UsesController != 0;
+    keyframePending = false;
+    return static_cast<bool>(in);
+}
+
+/// <summary>
+/// Reads the next simulation step. Movement and aim that were not written carry over from the previous step; keyframes in between are skipped.
+/// </summary>
+/// <param name="tick">Receives the step.</param>
+/// <returns>true if a step was read; false at the end of the recording or if it is cut off.</returns>
+bool ReplayReader::read(ReplayTick& tick) {
+    if (keyframePending && !skipKeyframe()) {
+        return false;
+    }
+    std::uint8_t flags;
+    if (position >= dataEnd || !get(flags)) {
+        return false;
+    }
+
+    tick = ReplayTick();
+    tick.restart = (flags & FLAG_RESTART) != 0;
+    tick.player1UsesController = last.player1UsesController != ((flags & FLAG_CONTROLLER) != 0);
+
+    PlayerInput* players[2] = { &tick.input.player1, &tick.input.player2 };
+    const PlayerInput* lastPlayers[2] = { &last.input.player1, &last.input.player2 };
+    for (int p = 0; p < 2; p++) {
+        std::uint8_t playerFlags = flags >> (p * PLAYER_SHIFT);
+        PlayerInput& input = *players[p];
+        input.move = lastPlayers[p]->move;
+        input.aim = lastPlayers[p]->aim;
+
+        bool complete = true;
+        if (playerFlags & FLAG_MOVE) {
+            complete = get(input.move.x) && get(input.move.y);
+        }
+        if (complete && (playerFlags & FLAG_AIM)) {
+            complete = get(input.aim.x) && get(input.aim.y);
+        }
+        if (complete && (playerFlags & FLAG_ACTION)) {
+            std::uint8_t actions = 0;
+            complete = get(actions);
+            input.shoot = (actions & ACTION_SHOOT) != 0;
+            input.throwWeapon = (actions & ACTION_THROW) != 0;
+            if (complete && input.shoot) {
+                complete = get(input.shootDelay);
+            }
+        }
+        if (!complete) {
+            return false;
+        }
+    }
+    last = tick;
+
+    ticksRead++;
+    keyframePending = header.keyframeInterval > 0 && ticksRead % header.keyframeInterval == 0;
+    return true;
+}
+
+/// <summary>
+/// Brings the simulation to the state after the given number of steps: restores the closest keyframe at or before it and applies the steps from there, at most keyframeInterval of them. Seeking forward within the current keyframe interval only applies the steps in between. Needs the index of a properly closed recording.
+/// </summary>
+/// <param name="simulation">The simulation the recording is replayed into.</param>
+/// <param name="tick">The number of steps to seek to; clamped to the length of the recording.</param>
+/// <returns>true if the simulation is at the requested step; false if the recording has no index or is damaged, in which case simulation and replay stay where they were.</returns>
+bool ReplayReader::seek(Simulation& simulation, std::uint64_t tick) {
+    if (index.empty()) {
+        return false;
+    }
+
+    // Stand vor dem Sprung merken; mit einem Teil der Daten weiterzulesen
+    // würde die Wiedergabe unbemerkt verfälschen
+    const std::uint64_t previousPosition = position;
+    const std::uint64_t previousTicksRead = ticksRead;
+    const ReplayTick previousLast = last;
+    const bool previousKeyframePending = keyframePending;
+    simulation.saveState(seekFallback);
+    if (seekTo(simulation, std::min(tick, totalTicks))) {
+        return true;
+    }
+
+    simulation.loadState(seekFallback);
+    position = previousPosition;
+    ticksRead = previousTicksRead;
+    last = previousLast;
+    keyframePending = previousKeyframePending;
+    in.clear();
+    in.seekg(static_cast<std::streamoff>(position));
+    return false;
+}
+
+/// <summary>
+/// Does the work of seek without undoing anything on failure.
+/// </summary>
+/// <param name="simulation">The simulation the recording is replayed into.</param>
+/// <param name="tick">The number of steps to seek to, at most the length of the recording.</param>
+/// <returns>true if the simulation is at the requested step; false if the recording is damaged.</returns>
+bool ReplayReader::seekTo(Simulation& simulation, std::uint64_t tick) {
+    // Letzter Keyframe bis zum Ziel; index[0] ist der Start
+    auto next = std::upper_bound(index.begin(), index.end(), tick,
+        [](std::uint64_t value, const ReplayKeyframe& keyframe) { return value < keyframe.tick; });
+    const ReplayKeyframe& keyframe = *(next - 1);
+
+    // Nur zurückspringen, wenn der Keyframe näher liegt als der aktuelle Schritt
+    if (tick < ticksRead || keyframe.tick > ticksRead) {
+        std::uint64_t keyframeTick = 0;
+        std::uint8_t player1UsesController = 0;
+        std::uint32_t size = 0;
+        in.clear();
+        in.seekg(static_cast<std::streamoff>(keyframe.offset));
+        position = keyframe.offset;
+        if (!get(keyframeTick) || !get(player1UsesController) || !get(size) || keyframeTick != keyframe.tick ||
+            position > dataEnd || size > dataEnd - position ||
+            !in.read(reinterpret_cast<char*>(keyframeState.resize(size)), size) || !simulation.loadState(keyframeState)) {
+            return false;
+        }
+        position += size;
+
+        last = ReplayTick();
+        last.player1UsesController = player1UsesController != 0;
+        simulation.getPlayer1().setIsControllerPlayer(last.player1UsesController);
+        ticksRead = keyframe.tick;
+        keyframePending = false;
+    }
+
+    ReplayTick step;
+    while (ticksRead < tick) {
+        if (!read(step)) {
+            return false;
+        }
+        applyReplayTick(simulation, header, step);
+    }
+    return true;
+}
+
+/// <summary>
+/// Applies a recorded step to the simulation: restarts it first if the step says so, including the horde of the recorded settings, then advances it with the recorded input.
+/// </summary>
+/// <param name="simulation">The simulation, created with the seed of the recording.</param>
+/// <param name="header">The header of the recording.</param>
+/// <param name="tick">The recorded step.</param>
+void applyReplayTick(Simulation& simulation, const ReplayHeader& header, const ReplayTick& tick) {
+    if (tick.restart) {
+        simulation.restart(tick.player1UsesController);
+        simulation.spawnHorde(static_cast<std::size_t>(header.horde));
+    }
+    simulation.getPlayer1().setIsControllerPlayer(tick.player1UsesController);
+    simulation.step(1.0f / header.tickRate, tick.input);
+}
+
+/// <summary>
+/// Mixes a value into an FNV-1a checksum byte by byte.
+/// </summary>
+/// <param name="hash">The checksum so far.</param>
+/// <param name="data">The bytes to mix in.</param>
+/// <param name="size">The number of bytes.</param>
+static void mix(std::uint64_t& hash, const void* data, std::size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 1099511628211ULL;
+    }
+}
+
+/// <summary>
+/// Computes a checksum over the step count, players, weapon, enemies and bullets. Two runs that end with the same checksum went through the same match, which makes it a quick check that a replay reproduced its recording.
+/// </summary>
+/// <param name="simulation">The simulation to check.</param>
+/// <returns>The checksum.</returns>
+std::uint64_t stateChecksum(const Simulation& simulation) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    unsigned long long ticks = simulation.getTickCount();
+    mix(hash, &ticks, sizeof(ticks));
+
+    for (const Player* player : { &simulation.getPlayer1(), &simulation.getPlayer2() }) {
+        float values[3] = { player->getPosition().x, player->getPosition().y, player->getRotation() };
+        int health = player->getHealth();
+        mix(hash, values, sizeof(values));
+        mix(hash, &health, sizeof(health));
+    }
+    sf::Vector2f weapon = simulation.getWeapon().getPosition();
+    mix(hash, &weapon, sizeof(weapon));
+
+    for (std::size_t h = 0; h < 2; h++) {
+        const ArenaHalf& half = simulation.getHalf(h);
+        mix(hash, half.enemies.x.data(), half.enemies.size() * sizeof(float));
+        mix(hash, half.enemies.y.data(), half.enemies.size() * sizeof(float));
+        mix(hash, half.bullets.x.data(), half.bullets.size() * sizeof(float));
+        mix(hash, half.bullets.y.data(), half.bullets.size() * sizeof(float));
+    }
+    return hash;
+}
\ No newline at end of file
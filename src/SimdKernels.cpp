@@ -0,0 +1,402 @@
+#include "../include/SimdKernels.h"
+#include "../include/Vector2Utils.h"
+#include <algorithm>
+#include <cmath>
+
+// Multiplikation und Addition nicht zu FMA zusammenfassen, sonst rundet der
+// Skalarpfad anders als die Vektor-Varianten
+#if defined(__clang__)
+#pragma clang fp contract(off)
+#elif defined(__GNUC__)
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define QT_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define QT_TARGET_AVX2
+#else
+#define QT_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace Simd {
+
+    // Skalare Referenz, gleichzeitig Rest-Schleife der Vektor-Varianten
+
+    static void seekScalar(float* x, float* y, float* vx, float* vy, std::size_t begin, std::size_t count,
+        float targetX, float targetY, float speed, float dt) {
+        for (std::size_t i = begin; i < count; i++) {
+            float dx = targetX - x[i];
+            float dy = targetY - y[i];
+            // Bei Abstand 0 ist rsqrt endlich, die Geschwindigkeit bleibt 0
+            float scale = speed * Utils::rsqrt(dx * dx + dy * dy);
+
+            vx[i] = dx * scale;
+            vy[i] = dy * scale;
+            x[i] += vx[i] * dt;
+            y[i] += vy[i] * dt;
+        }
+    }
+
+    static void normalizeScalar(float* x, float* y, std::size_t begin, std::size_t count) {
+        for (std::size_t i = begin; i < count; i++) {
+            float scale = Utils::rsqrt(x[i] * x[i] + y[i] * y[i]);
+            x[i] *= scale;
+            y[i] *= scale;
+        }
+    }
+
+    static void advanceBulletsScalar(float* x, float* y, const float* vx, const float* vy, std::uint8_t* status,
+        std::size_t begin, std::size_t count, float dt, float width, float height, float stopX, bool stopRight) {
+        for (std::size_t i = begin; i < count; i++) {
+            x[i] += vx[i] * dt;
+            y[i] += vy[i] * dt;
+
+            bool outside = x[i] < 0 || x[i] > width || y[i] < 0 || y[i] > height;
+            bool pastStop = stopRight ? x[i] >= stopX : x[i] <= stopX;
+            status[i] = (outside ? BULLET_OUT_OF_BOUNDS : 0) | (pastStop ? BULLET_PAST_STOP : 0);
+        }
+    }
+
+    static void overlapMaskScalar(const float* x, const float* y, std::size_t begin, std::size_t count,
+        float centerX, float centerY, float radiusSquared, std::uint64_t* mask) {
+        for (std::size_t i = begin; i < count; i++) {
+            float dx = x[i] - centerX;
+            float dy = y[i] - centerY;
+            if (dx * dx + dy * dy < radiusSquared) {
+                mask[i / 64] |= std::uint64_t(1) << (i % 64);
+            }
+        }
+    }
+
+#ifdef QT_SIMD_X86
+
+    // SSE: 4 Gegner bzw. Kugeln pro Durchlauf
+
+    // Utils::rsqrt für 4 Werte, mit denselben Operationen in derselben Reihenfolge
+    static inline __m128 rsqrtSSE(__m128 x) {
+        __m128i bits = _mm_sub_epi32(_mm_set1_epi32(0x5f375a86), _mm_srli_epi32(_mm_castps_si128(x), 1));
+        __m128 y = _mm_castsi128_ps(bits);
+        const __m128 half = _mm_mul_ps(_mm_set1_ps(0.5f), x), threeHalves = _mm_set1_ps(1.5f);
+        y = _mm_mul_ps(y, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, y), y)));
+        y = _mm_mul_ps(y, _mm_sub_ps(threeHalves, _mm_mul_ps(_mm_mul_ps(half, y), y)));
+        return y;
+    }
+
+    static void seekSSE(float* x, float* y, float* vx, float* vy, std::size_t count,
+        float targetX, float targetY, float speed, float dt) {
+        const __m128 tx = _mm_set1_ps(targetX), ty = _mm_set1_ps(targetY);
+        const __m128 s = _mm_set1_ps(speed), t = _mm_set1_ps(dt);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i);
+            __m128 dx = _mm_sub_ps(tx, px), dy = _mm_sub_ps(ty, py);
+            __m128 scale = _mm_mul_ps(s, rsqrtSSE(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy))));
+
+            __m128 nvx = _mm_mul_ps(dx, scale), nvy = _mm_mul_ps(dy, scale);
+            _mm_storeu_ps(vx + i, nvx);
+            _mm_storeu_ps(vy + i, nvy);
+            _mm_storeu_ps(x + i, _mm_add_ps(px, _mm_mul_ps(nvx, t)));
+            _mm_storeu_ps(y + i, _mm_add_ps(py, _mm_mul_ps(nvy, t)));
+        }
+        seekScalar(x, y, vx, vy, i, count, targetX, targetY, speed, dt);
+    }
+
+    static void normalizeSSE(float* x, float* y, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 px = _mm_loadu_ps(x + i), py = _mm_loadu_ps(y + i);
+            __m128 scale = rsqrtSSE(_mm_add_ps(_mm_mul_ps(px, px), _mm_mul_ps(py, py)));
+            _mm_storeu_ps(x + i, _mm_mul_ps(px, scale));
+            _mm_storeu_ps(y + i, _mm_mul_ps(py, scale));
+        }
+        normalizeScalar(x, y, i, count);
+    }
+
+    static void advanceBulletsSSE(float* x, float* y, const float* vx, const float* vy, std::uint8_t* status,
+        std::size_t count, float dt, float width, float height, float stopX, bool stopRight) {
+        const __m128 t = _mm_set1_ps(dt), zero = _mm_setzero_ps();
+        const __m128 w = _mm_set1_ps(width), h = _mm_set1_ps(height), stop = _mm_set1_ps(stopX);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 px = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(_mm_loadu_ps(vx + i), t));
+            __m128 py = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(_mm_loadu_ps(vy + i), t));
+            _mm_storeu_ps(x + i, px);
+            _mm_storeu_ps(y + i, py);
+
+            __m128 outside = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(px, zero), _mm_cmpgt_ps(px, w)),
+                _mm_or_ps(_mm_cmplt_ps(py, zero), _mm_cmpgt_ps(py, h)));
+            __m128 pastStop = stopRight ? _mm_cmpge_ps(px, stop) : _mm_cmple_ps(px, stop);
+
+            int outsideBits = _mm_movemask_ps(outside);
+            int stopBits = _mm_movemask_ps(pastStop);
+            for (int k = 0; k < 4; k++) {
+                status[i + k] = static_cast<std::uint8_t>(((outsideBits >> k) & 1) | (((stopBits >> k) & 1) << 1));
+            }
+        }
+        advanceBulletsScalar(x, y, vx, vy, status, i, count, dt, width, height, stopX, stopRight);
+    }
+
+    static void overlapMaskSSE(const float* x, const float* y, std::size_t count,
+        float centerX, float centerY, float radiusSquared, std::uint64_t* mask) {
+        const __m128 cx = _mm_set1_ps(centerX), cy = _mm_set1_ps(centerY), r2 = _mm_set1_ps(radiusSquared);
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), cx);
+            __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), cy);
+            __m128 inside = _mm_cmplt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), r2);
+            // i ist durch 4 teilbar, die 4 Bits liegen also immer im selben Wort
+            mask[i / 64] |= static_cast<std::uint64_t>(_mm_movemask_ps(inside)) << (i % 64);
+        }
+        overlapMaskScalar(x, y, i, count, centerX, centerY, radiusSquared, mask);
+    }
+
+    // AVX2: 8 Gegner bzw. Kugeln pro Durchlauf
+
+    QT_TARGET_AVX2 static inline __m256 rsqrtAVX2(__m256 x) {
+        __m256i bits = _mm256_sub_epi32(_mm256_set1_epi32(0x5f375a86), _mm256_srli_epi32(_mm256_castps_si256(x), 1));
+        __m256 y = _mm256_castsi256_ps(bits);
+        const __m256 half = _mm256_mul_ps(_mm256_set1_ps(0.5f), x), threeHalves = _mm256_set1_ps(1.5f);
+        y = _mm256_mul_ps(y, _mm256_sub_ps(threeHalves, _mm256_mul_ps(_mm256_mul_ps(half, y), y)));
+        y = _mm256_mul_ps(y, _mm256_sub_ps(threeHalves, _mm256_mul_ps(_mm256_mul_ps(half, y), y)));
+        return y;
+    }
+
+    QT_TARGET_AVX2 static void seekAVX2(float* x, float* y, float* vx, float* vy, std::size_t count,
+        float targetX, float targetY, float speed, float dt) {
+        const __m256 tx = _mm256_set1_ps(targetX), ty = _mm256_set1_ps(targetY);
+        const __m256 s = _mm256_set1_ps(speed), t = _mm256_set1_ps(dt);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i);
+            __m256 dx = _mm256_sub_ps(tx, px), dy = _mm256_sub_ps(ty, py);
+            __m256 scale = _mm256_mul_ps(s, rsqrtAVX2(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy))));
+
+            __m256 nvx = _mm256_mul_ps(dx, scale), nvy = _mm256_mul_ps(dy, scale);
+            _mm256_storeu_ps(vx + i, nvx);
+            _mm256_storeu_ps(vy + i, nvy);
+            _mm256_storeu_ps(x + i, _mm256_add_ps(px, _mm256_mul_ps(nvx, t)));
+            _mm256_storeu_ps(y + i, _mm256_add_ps(py, _mm256_mul_ps(nvy, t)));
+        }
+        // Obere Registerhälften leeren, sonst bremsen sie nachfolgenden SSE-Code aus
+        _mm256_zeroupper();
+        seekScalar(x, y, vx, vy, i, count, targetX, targetY, speed, dt);
+    }
+
+    QT_TARGET_AVX2 static void normalizeAVX2(float* x, float* y, std::size_t count) {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 px = _mm256_loadu_ps(x + i), py = _mm256_loadu_ps(y + i);
+            __m256 scale = rsqrtAVX2(_mm256_add_ps(_mm256_mul_ps(px, px), _mm256_mul_ps(py, py)));
+            _mm256_storeu_ps(x + i, _mm256_mul_ps(px, scale));
+            _mm256_storeu_ps(y + i, _mm256_mul_ps(py, scale));
+        }
+        _mm256_zeroupper();
+        normalizeScalar(x, y, i, count);
+    }
+
+    QT_TARGET_AVX2 static void advanceBulletsAVX2(float* x, float* y, const float* vx, const float* vy, std::uint8_t* status,
+        std::size_t count, float dt, float width, float height, float stopX, bool stopRight) {
+        const __m256 t = _mm256_set1_ps(dt), zero = _mm256_setzero_ps();
+        const __m256 w = _mm256_set1_ps(width), h = _mm256_set1_ps(height), stop = _mm256_set1_ps(stopX);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 px = _mm256_add_ps(_mm256_loadu_ps(x + i), _mm256_mul_ps(_mm256_loadu_ps(vx + i), t));
+            __m256 py = _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_mul_ps(_mm256_loadu_ps(vy + i), t));
+            _mm256_storeu_ps(x + i, px);
+            _mm256_storeu_ps(y + i, py);
+
+            __m256 outside = _mm256_or_ps(
+                _mm256_or_ps(_mm256_cmp_ps(px, zero, _CMP_LT_OQ), _mm256_cmp_ps(px, w, _CMP_GT_OQ)),
+                _mm256_or_ps(_mm256_cmp_ps(py, zero, _CMP_LT_OQ), _mm256_cmp_ps(py, h, _CMP_GT_OQ)));
+            __m256 pastStop = stopRight ? _mm256_cmp_ps(px, stop, _CMP_GE_OQ) : _mm256_cmp_ps(px, stop, _CMP_LE_OQ);
+
+            int outsideBits = _mm256_movemask_ps(outside);
+            int stopBits = _mm256_movemask_ps(pastStop);
+            for (int k = 0; k < 8; k++) {
+                status[i + k] = static_cast<std::uint8_t>(((outsideBits >> k) & 1) | (((stopBits >> k) & 1) << 1));
+            }
+        }
+        _mm256_zeroupper();
+        advanceBulletsScalar(x, y, vx, vy, status, i, count, dt, width, height, stopX, stopRight);
+    }
+
+    QT_TARGET_AVX2 static void overlapMaskAVX2(const float* x, const float* y, std::size_t count,
+        float centerX, float centerY, float radiusSquared, std::uint64_t* mask) {
+        const __m256 cx = _mm256_set1_ps(centerX), cy = _mm256_set1_ps(centerY), r2 = _mm256_set1_ps(radiusSquared);
+
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), cx);
+            __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), cy);
+            __m256 inside = _mm256_cmp_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), r2, _CMP_LT_OQ);
+            mask[i / 64] |= static_cast<std::uint64_t>(_mm256_movemask_ps(inside)) << (i % 64);
+        }
+        _mm256_zeroupper();
+        overlapMaskScalar(x, y, i, count, centerX, centerY, radiusSquared, mask);
+    }
+
+#endif
+
+    /// <summary>
+    /// Detects the highest instruction set level supported by the CPU and the operating system.
+    /// </summary>
+    /// <returns>AVX2 if the CPU supports it and the OS saves the AVX registers, SSE on any other x86 CPU, otherwise Scalar.</returns>
+    Level detectLevel() {
+#if defined(QT_SIMD_X86) && defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] >= 7) {
+            __cpuid(info, 1);
+            bool osxsave = (info[2] & (1 << 27)) != 0;
+            bool avx = (info[2] & (1 << 28)) != 0;
+            if (osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+                __cpuidex(info, 7, 0);
+                if (info[1] & (1 << 5)) {
+                    return Level::AVX2;
+                }
+            }
+        }
+        return Level::SSE;
+#elif defined(QT_SIMD_X86)
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return Level::AVX2;
+        }
+        return __builtin_cpu_supports("sse2") ? Level::SSE : Level::Scalar;
+#else
+        return Level::Scalar;
+#endif
+    }
+
+    static Level& activeLevel() {
+        static Level level = detectLevel();
+        return level;
+    }
+
+    /// <summary>
+    /// Returns the instruction set level the kernels currently use.
+    /// </summary>
+    /// <returns>The active level.</returns>
+    Level getLevel() {
+        return activeLevel();
+    }
+
+    /// <summary>
+    /// Selects the instruction set level the kernels use, for comparisons and benchmarks. Levels the CPU does not support fall back to the detected level.
+    /// </summary>
+    /// <param name="level">The requested level.</param>
+    void setLevel(Level level) {
+        Level supported = detectLevel();
+        activeLevel() = static_cast<int>(level) <= static_cast<int>(supported) ? level : supported;
+    }
+
+    /// <summary>
+    /// Returns a printable name for an instruction set level.
+    /// </summary>
+    /// <param name="level">The level.</param>
+    /// <returns>"Skalar", "SSE" or "AVX2".</returns>
+    const char* getLevelName(Level level) {
+        switch (level) {
+        case Level::SSE: return "SSE";
+        case Level::AVX2: return "AVX2";
+        default: return "Skalar";
+        }
+    }
+
+    /// <summary>
+    /// Moves every enemy with the given speed toward the target and stores its velocity, using the active instruction set level.
+    /// </summary>
+    /// <param name="x">The x-coordinates of the enemies.</param>
+    /// <param name="y">The y-coordinates of the enemies.</param>
+    /// <param name="vx">Receives the x-velocities of the enemies.</param>
+    /// <param name="vy">Receives the y-velocities of the enemies.</param>
+    /// <param name="count">The number of enemies.</param>
+    /// <param name="targetX">The x-coordinate of the target.</param>
+    /// <param name="targetY">The y-coordinate of the target.</param>
+    /// <param name="speed">The movement speed, in pixels per second.</param>
+    /// <param name="dt">The duration of the step, in seconds.</param>
+    void seek(float* x, float* y, float* vx, float* vy, std::size_t count,
+        float targetX, float targetY, float speed, float dt) {
+        switch (activeLevel()) {
+#ifdef QT_SIMD_X86
+        case Level::AVX2: seekAVX2(x, y, vx, vy, count, targetX, targetY, speed, dt); return;
+        case Level::SSE: seekSSE(x, y, vx, vy, count, targetX, targetY, speed, dt); return;
+#endif
+        default: seekScalar(x, y, vx, vy, 0, count, targetX, targetY, speed, dt); return;
+        }
+    }
+
+    /// <summary>
+    /// Normalizes every vector in place with the reciprocal square root of Utils::rsqrt, using the active instruction set level. It takes the same steps as Utils::fastNormalize, so it has the same error bound, and all levels agree bit for bit; zero vectors stay zero.
+    /// </summary>
+    /// <param name="x">The x-components of the vectors.</param>
+    /// <param name="y">The y-components of the vectors.</param>
+    /// <param name="count">The number of vectors.</param>
+    void normalize(float* x, float* y, std::size_t count) {
+        switch (activeLevel()) {
+#ifdef QT_SIMD_X86
+        case Level::AVX2: normalizeAVX2(x, y, count); return;
+        case Level::SSE: normalizeSSE(x, y, count); return;
+#endif
+        default: normalizeScalar(x, y, 0, count); return;
+        }
+    }
+
+    /// <summary>
+    /// Marks every point that lies strictly inside the given circle in a bitmask, using the active instruction set level. Compares squared distances, so no square root is taken.
+    /// </summary>
+    /// <param name="x">The x-coordinates of the points.</param>
+    /// <param name="y">The y-coordinates of the points.</param>
+    /// <param name="count">The number of points.</param>
+    /// <param name="centerX">The x-coordinate of the circle's center.</param>
+    /// <param name="centerY">The y-coordinate of the circle's center.</param>
+    /// <param name="radius">The radius of the circle.</param>
+    /// <param name="mask">Receives one bit per point, 64 points per word; must hold (count + 63) / 64 words.</param>
+    void overlapMask(const float* x, const float* y, std::size_t count,
+        float centerX, float centerY, float radius, std::uint64_t* mask) {
+        std::fill(mask, mask + (count + 63) / 64, std::uint64_t(0));
+        float radiusSquared = radius * radius;
+
+        switch (activeLevel()) {
+#ifdef QT_SIMD_X86
+        case Level::AVX2: overlapMaskAVX2(x, y, count, centerX, centerY, radiusSquared, mask); return;
+        case Level::SSE: overlapMaskSSE(x, y, count, centerX, centerY, radiusSquared, mask); return;
+#endif
+        default: overlapMaskScalar(x, y, 0, count, centerX, centerY, radiusSquared, mask); return;
+        }
+    }
+
+    /// <summary>
+    /// Moves every bullet along its velocity and records for each bullet whether it left the area or reached the stop line, using the active instruction set level.
+    /// </summary>
+    /// <param name="x">The x-coordinates of the bullets.</param>
+    /// <param name="y">The y-coordinates of the bullets.</param>
+    /// <param name="vx">The x-velocities of the bullets.</param>
+    /// <param name="vy">The y-velocities of the bullets.</param>
+    /// <param name="status">Receives BULLET_OUT_OF_BOUNDS and BULLET_PAST_STOP for each bullet.</param>
+    /// <param name="count">The number of bullets.</param>
+    /// <param name="dt">The duration of the step, in seconds.</param>
+    /// <param name="width">The width of the area.</param>
+    /// <param name="height">The height of the area.</param>
+    /// <param name="stopX">The x-coordinate of the stop line.</param>
+    /// <param name="stopRight">true if bullets stop at or right of the line, false if at or left of it.</param>
+    void advanceBullets(float* x, float* y, const float* vx, const float* vy, std::uint8_t* status,
+        std::size_t count, float dt, float width, float height, float stopX, bool stopRight) {
+        switch (activeLevel()) {
+#ifdef QT_SIMD_X86
+        case Level::AVX2: advanceBulletsAVX2(x, y, vx, vy, status, count, dt, width, height, stopX, stopRight); return;
+        case Level::SSE: advanceBulletsSSE(x, y, vx, vy, status, count, dt, width, height, stopX, stopRight); return;
+#endif
+        default: advanceBulletsScalar(x, y, vx, vy, status, 0, count, dt, width, height, stopX, stopRight); return;
+        }
+    }
+}
\ No newline at end of file
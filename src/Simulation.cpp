@@ -0,0 +1,265 @@
+#include "../include/Simulation.h"
+#include "../include/Constants.h"
+#include "../include/Vector2Utils.h"
+#include "../include/SimulationState.h"
+#include <algorithm>
+
+using namespace Constants;
+
+// Kennung des Speicherlayouts im Spielstand; Stände eines Builds mit anderem
+// Layout werden beim Laden abgelehnt
+static const std::uint32_t STATE_LAYOUT =
+    static_cast<std::uint32_t>(sizeof(Player) << 24 ^ sizeof(Weapon) << 16 ^ sizeof(std::mt19937));
+
+/// <summary>
+/// Initializes a new simulation with both players at their start positions, player 1 holding the weapon, and the enemy spawner seeded with the given value.
+/// </summary>
+/// <param name="seed">Seed for the random number generator used by the enemy spawner.</param>
+/// <param name="player1UsesController">Indicates whether player 1 is controlled by a controller.</param>
+/// <param name="threads">The number of threads for the data-parallel passes; 0 uses all hardware threads. The results do not depend on it.</param>
+Simulation::Simulation(unsigned int seed, bool player1UsesController, unsigned int threads)
+    : player1(WINDOW_WIDTH / 4.0f, WINDOW_HEIGHT / 2.0f, player1UsesController, 0),
+    player2(3 * WINDOW_WIDTH / 4.0f, WINDOW_HEIGHT / 2.0f, false),
+    weapon(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f),
+    halves{ ArenaHalf(true), ArenaHalf(false) },
+    jobs(threads),
+    seed(seed),
+    rng(seed),
+    spawnY(50.0f, WINDOW_HEIGHT - 50.0f),
+    spawnTimer(0.0f),
+    invulnerable(false),
+    gameOver(false),
+    tickCount(0) {
+
+    // Spieler 1 startet mit der Waffe
+    weapon.checkPickup(player1, 0);
+}
+
+/// <summary>
+/// Advances the simulation by one step: applies the players' actions, moves players, weapon, enemies and bullets, spawns new enemies, resolves collisions and checks for game over.
+/// </summary>
+/// <param name="dt">The simulated time for this step, in seconds.</param>
+/// <param name="input">The input of both players for this step.</param>
+void Simulation::step(float dt, const TickInput& input) {
+    if (gameOver) {
+        return;
+    }
+    tickCount++;
+
+    // Schießen und Werfen
+    applyActions(player1, 0, player2, input.player1, dt);
+    applyActions(player2, 1, player1, input.player2, dt);
+
+    // Spieler updaten
+    player1.update(dt, input.player1);
+    player2.update(dt, input.player2);
+
+    // Waffe updaten
+    weapon.update(dt, player1, player2);
+    weapon.checkPickup(player1, 0);
+    weapon.checkPickup(player2, 1);
+
+    // Gegner spawnen
+    spawnTimer += dt;
+    if (spawnTimer > ENEMY_SPAWN_INTERVAL) {
+        spawnTimer = 0.0f;
+        spawnEnemies();
+    }
+
+    // Gegner, Kugeln und Kollisionen getrennt je Hälfte. Die Hälften teilen
+    // keine Daten: alles, was beide Seiten berührt (Würfe, Waffe, Aufheben,
+    // Spawning mit dem gemeinsamen Zufallsgenerator), ist oben schon erledigt.
+    // Das ist die einzige Synchronisation pro Schritt.
+    Player* players[2] = { &player1, &player2 };
+    int contacts[2];
+    if (shouldRunHalvesInParallel()) {
+        jobs.parallelFor(2, 1, [&](std::size_t, std::size_t, std::size_t half) {
+            contacts[half] = halves[half].update(dt, *players[half], jobs);
+        });
+    }
+    else {
+        contacts[0] = halves[0].update(dt, player1, jobs);
+        contacts[1] = halves[1].update(dt, player2, jobs);
+    }
+    if (!invulnerable) {
+        for (int i = 0; i < contacts[0]; i++) player1.takeDamage();
+        for (int i = 0; i < contacts[1]; i++) player2.takeDamage();
+    }
+
+    // Game Over prüfen
+    if (!player1.isAlive() || !player2.isAlive()) {
+        gameOver = true;
+    }
+}
+
+/// <summary>
+/// Decides whether the two halves are updated at the same time, each as one job. Only worth it when both halves have enough work to outweigh waking a worker, and when the enemy passes inside a half would run as a single block anyway: with more enemies, splitting each half across all threads is faster than two threads with one half each. Both ways give the same result.
+/// </summary>
+/// <returns>true to update the halves in parallel; false to update them one after the other.</returns>
+bool Simulation::shouldRunHalvesInParallel() const {
+    if (jobs.getThreadCount() < 2) {
+        return false;
+    }
+    for (const ArenaHalf& half : halves) {
+        if (half.getWorkload() < PARALLEL_HALVES_MIN_WORK || half.enemies.size() > PARALLEL_ENEMY_GRAIN) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// <summary>
+/// Applies the shoot and throw actions of a player for the current step.
+/// </summary>
+/// <param name="player">The player whose actions are applied.</param>
+/// <param name="playerIndex">The index of that player, 0 or 1.</param>
+/// <param name="partner">The other player, who is the target of a throw.</param>
+/// <param name="input">The input of the player for this step.</param>
+/// <param name="dt">The simulated time for this step, in seconds.</param>
+void Simulation::applyActions(Player& player, int playerIndex, const Player& partner, const PlayerInput& input, float dt) {
+    if (input.shoot && player.getHasWeapon()) {
+        shoot(player, input.shootDelay, dt);
+    }
+    if (input.throwWeapon && player.getHasWeapon()) {
+        weapon.throwTo(player, playerIndex, partner);
+    }
+}
+
+/// <summary>
+/// Fires a bullet from the specified player if they have a weapon. The bullet belongs to the half it is fired in. A shot fired partway into the step starts that far behind the muzzle, so that after the step's movement it is only as far along as the time since the shot allows; the offset is capped at the muzzle distance, so the bullet never starts behind the player.
+/// </summary>
+/// <param name="player">Reference to the player who is attempting to shoot.</param>
+/// <param name="delay">The fraction of the step that had passed when the shot was fired, from 0 to 1.</param>
+/// <param name="dt">The simulated time for this step, in seconds.</param>
+void Simulation::shoot(Player& player, float delay, float dt) {
+    if (player.getHasWeapon()) {
+        const float muzzleDistance = 30.0f;
+        float offset = muzzleDistance - std::min(BULLET_SPEED * dt * delay, muzzleDistance);
+        sf::Vector2f spawnPos = player.getPosition() + player.getAimDirection() * offset;
+        ArenaHalf& half = spawnPos.x < WINDOW_WIDTH / 2.0f ? halves[0] : halves[1];
+        half.bullets.add(spawnPos.x, spawnPos.y, player.getAimDirection());
+    }
+}
+
+/// <summary>
+/// Spawns a new wave of enemies on both sides, with additional spawns from the top and bottom once there are many enemies.
+/// </summary>
+void Simulation::spawnEnemies() {
+    // Spawn auf beiden Seiten
+    float y1 = spawnY(rng);
+    float y2 = spawnY(rng);
+
+    halves[0].enemies.add(0, y1);
+    halves[1].enemies.add(static_cast<float>(WINDOW_WIDTH), y2);
+
+    // Zusätzliche Spawns bei vielen Gegnern
+    if (getEnemyCount() > 10) {
+        float x1 = std::uniform_real_distribution<float>(50, WINDOW_WIDTH / 2.0f - 50)(rng);
+        float x2 = std::uniform_real_distribution<float>(WINDOW_WIDTH / 2.0f + 50, WINDOW_WIDTH - 50)(rng);
+        halves[0].enemies.add(x1, 0);
+        halves[1].enemies.add(x2, static_cast<float>(WINDOW_HEIGHT));
+    }
+}
+
+/// <summary>
+/// Spawns a horde of enemies at random positions, half of them on each side, for stress tests and benchmarks. Enemies are kept out of a safety zone around the players. The enemy pools are enlarged to fit the horde on top of the regular pool size.
+/// </summary>
+/// <param name="count">The number of enemies to spawn.</param>
+void Simulation::spawnHorde(std::size_t count) {
+    for (ArenaHalf& half : halves) {
+        half.reserveEnemies(half.enemies.size() + (count + 1) / 2 + ENEMY_POOL_SIZE);
+    }
+
+    const float safeDistance = 150.0f;
+    std::uniform_real_distribution<float> leftX(0.0f, WINDOW_WIDTH / 2.0f - 10);
+    std::uniform_real_distribution<float> rightX(WINDOW_WIDTH / 2.0f + 10, static_cast<float>(WINDOW_WIDTH));
+    std::uniform_real_distribution<float> anyY(0.0f, static_cast<float>(WINDOW_HEIGHT));
+
+    for (std::size_t i = 0; i < count; i++) {
+        bool left = i % 2 == 0;
+        const Player& target = left ? player1 : player2;
+
+        sf::Vector2f position;
+        do {
+            position.x = left ? leftX(rng) : rightX(rng);
+            position.y = anyY(rng);
+        } while (Utils::isWithin(position, target.getPosition(), safeDistance));
+
+        halves[left ? 0 : 1].enemies.add(position.x, position.y);
+    }
+}
+
+/// <summary>
+/// Adds an obstacle that enemies path around. An obstacle across the middle line is split between both halves. Obstacles are kept across restarts.
+/// </summary>
+/// <param name="left">The x-coordinate of the left edge of the obstacle.</param>
+/// <param name="top">The y-coordinate of the top edge of the obstacle.</param>
+/// <param name="width">The width of the obstacle.</param>
+/// <param name="height">The height of the obstacle.</param>
+void Simulation::addObstacle(float left, float top, float width, float height) {
+    for (ArenaHalf& half : halves) {
+        float clippedLeft = std::max(left, half.getLeft());
+        float clippedRight = std::min(left + width, half.getRight());
+        if (clippedLeft < clippedRight) {
+            half.addObstacle(clippedLeft, top, clippedRight - clippedLeft, height);
+        }
+    }
+}
+
+/// <summary>
+/// Resets the simulation to its initial configuration, including players, weapon, enemies, and bullets.
+/// </summary>
+/// <param name="player1UsesController">Indicates whether player 1 is controlled by a controller.</param>
+void Simulation::restart(bool player1UsesController) {
+    // Spieler zurücksetzen
+    player1 = Player(WINDOW_WIDTH / 4.0f, WINDOW_HEIGHT / 2.0f, player1UsesController, 0);
+    player2 = Player(3 * WINDOW_WIDTH / 4.0f, WINDOW_HEIGHT / 2.0f, false);
+
+    // Waffe zurücksetzen
+    weapon = Weapon(WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f);
+    weapon.checkPickup(player1, 0);
+
+    // Listen leeren
+    halves[0].clear();
+    halves[1].clear();
+
+    // Spiel fortsetzen
+    gameOver = false;
+    spawnTimer = 0.0f;
+}
+
+/// <summary>
+/// Writes the complete state of the match into a flat block: players, weapon and random number generator are copied as a whole, the enemies and bullets of both halves as arrays. Loading it into a simulation with the same obstacles continues the match exactly as this one would. Obstacles and the thread count are settings, not state. The block keeps its memory, so saving into the same block again does not allocate.
+/// </summary>
+/// <param name="state">The block that receives the state; its previous content is replaced.</param>
+void Simulation::saveState(SimulationState& state) const {
+    state.clear();
+    state.write(STATE_LAYOUT);
+    state.write(player1);
+    state.write(player2);
+    state.write(weapon);
+    state.write(rng);
+    state.write(seed);
+    state.write(spawnTimer);
+    state.write(invulnerable);
+    state.write(gameOver);
+    state.write(tickCount);
+    halves[0].saveState(state);
+    halves[1].saveState(state);
+}
+
+/// <summary>
+/// Restores the state written by saveState of a build with the same memory layout. Apart from enlarging the pools for a larger saved horde this does not allocate. If the block is damaged, the simulation is left in a mixed state and should be restarted.
+/// </summary>
+/// <param name="state">The block written by saveState.</param>
+/// <returns>true if the state was read completely; otherwise, false.</returns>
+bool Simulation::loadState(const SimulationState& state) {
+    StateReader in(state);
+    std::uint32_t layout = 0;
+    if (!in.read(layout) || layout != STATE_LAYOUT) {
+        return false;
+    }
+    return in.read(player1) && in.read(player2) && in.read(weapon) && in.read(rng) &&
+        in.read(seed) && in.read(spawnTimer) && in.read(invulnerable) && in.read(gameOver) && in.read(tickCount) &&
+        halves[0].loadState(in) && halves[1].loadState(in) && in.atEnd();
+}
\ No newline at end of file
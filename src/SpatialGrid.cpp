@@ -0,0 +1,65 @@
+#include "../include/SpatialGrid.h"
+#include <cmath>
+
+/// <summary>
+/// Constructs a grid that covers the given rectangle with square cells. Positions outside the rectangle are clamped into the border cells.
+/// </summary>
+/// <param name="left">The x-coordinate of the left edge of the covered area.</param>
+/// <param name="top">The y-coordinate of the top edge of the covered area.</param>
+/// <param name="width">The width of the covered area.</param>
+/// <param name="height">The height of the covered area.</param>
+/// <param name="cellSize">The edge length of a cell; should be at least the largest query radius.</param>
+SpatialGrid::SpatialGrid(float left, float top, float width, float height, float cellSize)
+    : originX(left), originY(top), cellSize(cellSize), inverseCellSize(1.0f / cellSize),
+    columns(std::max(1, static_cast<int>(std::ceil(width / cellSize)))),
+    rows(std::max(1, static_cast<int>(std::ceil(height / cellSize)))) {
+    cellStart.assign(columns * rows + 1, 0);
+    cellSumX.assign(columns * rows, 0.0f);
+    cellSumY.assign(columns * rows, 0.0f);
+}
+
+/// <summary>
+/// Allocates room for the given number of entries, so that building the grid with up to that many entries does not allocate.
+/// </summary>
+/// <param name="count">The number of entries to make room for.</param>
+void SpatialGrid::reserve(std::size_t count) {
+    entries.reserve(count);
+    entryCell.reserve(count);
+}
+
+/// <summary>
+/// Rebuilds the grid from the given positions in O(n) using a counting sort. Indices within a cell end up in ascending order. The positions of each cell are summed up as well, for sumAround.
+/// </summary>
+/// <param name="x">The x-coordinates of the entries.</param>
+/// <param name="y">The y-coordinates of the entries.</param>
+void SpatialGrid::build(const std::vector<float>& x, const std::vector<float>& y) {
+    const std::size_t count = x.size();
+    const int cellCount = columns * rows;
+
+    // Einträge pro Zelle zählen und Positionen aufsummieren
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    std::fill(cellSumX.begin(), cellSumX.end(), 0.0f);
+    std::fill(cellSumY.begin(), cellSumY.end(), 0.0f);
+    entryCell.resize(count);
+    for (std::size_t i = 0; i < count; i++) {
+        std::uint32_t cell = row(y[i]) * columns + column(x[i]);
+        entryCell[i] = cell;
+        cellStart[cell]++;
+        cellSumX[cell] += x[i];
+        cellSumY[cell] += y[i];
+    }
+
+    // Präfixsumme: cellStart[c] zeigt danach auf das Ende von Zelle c
+    std::uint32_t sum = 0;
+    for (int c = 0; c < cellCount; c++) {
+        sum += cellStart[c];
+        cellStart[c] = sum;
+    }
+    cellStart[cellCount] = sum;
+
+    // Rückwärts einsortieren, damit cellStart[c] am Ende auf den Anfang zeigt
+    entries.resize(count);
+    for (std::size_t i = count; i-- > 0;) {
+        entries[--cellStart[entryCell[i]]] = static_cast<std::uint32_t>(i);
+    }
+}
\ No newline at end of file
@@ -11,97 +11,94 @@ using namespace Utils;
 /// </summary>
 /// <param name="x">The x-coordinate of the weapon's initial position.</param>
 /// <param name="y">The y-coordinate of the weapon's initial position.</param>
-Weapon::Weapon(float x, float y) : position(x, y), isFlying(false), holder(nullptr),
-lastHolder(nullptr), throwCooldown(0.0f) {
-    shape.setSize(sf::Vector2f(30, 10));
-    shape.setFillColor(sf::Color::Black);
-    shape.setOrigin(15, 5);
-    shape.setPosition(position);
+Weapon::Weapon(float x, float y) : position(x, y), rotation(0.0f), previousPosition(x, y),
+previousRotation(0.0f), isFlying(false), holder(NO_HOLDER),
+lastHolder(NO_HOLDER), throwCooldown(0.0f) {
 }
 
 /// <summary>
 /// Updates the weapon's position, velocity, and rotation based on its current state (flying or held).
 /// </summary>
 /// <param name="dt">The time elapsed since the last update, in seconds.</param>
-void Weapon::update(float dt) {
+/// <param name="player1">Player 1, followed by the weapon if it holds it.</param>
+/// <param name="player2">Player 2, followed by the weapon if it holds it.</param>
+void Weapon::update(float dt, const Player& player1, const Player& player2) {
+    previousPosition = position;
+    previousRotation = rotation;
+
     // Update cooldown timer
     if (throwCooldown > 0) {
         throwCooldown -= dt;
         if (throwCooldown < 0) {
             throwCooldown = 0;
-            lastHolder = nullptr; // Reset last holder after cooldown
+            lastHolder = NO_HOLDER; // Reset last holder after cooldown
         }
     }
 
     if (isFlying) {
         position += velocity * dt;
-        shape.setPosition(position);
 
         // Rotation basierend auf Flugrichtung
-        float angle = toDegrees(std::atan2(velocity.y, velocity.x));
-        shape.setRotation(angle);
+        rotation = toDegrees(fastAtan2(velocity.y, velocity.x));
 
-        velocity *= 0.98f;
+        // Luftwiderstand unabhängig von der Schrittweite
+        velocity *= std::pow(WEAPON_DRAG, dt * 60.0f);
 
         if (std::abs(velocity.x) < 10 && std::abs(velocity.y) < 10) {
             isFlying = false;
             velocity = sf::Vector2f(0, 0);
         }
     }
-    else if (holder) {
+    else if (holder != NO_HOLDER) {
         // Waffe folgt dem Spieler und seiner Rotation
-        float rad = toRadians(holder->getRotation());
-        position = holder->getPosition() + sf::Vector2f(std::cos(rad) * 30, std::sin(rad) * 30);
-        shape.setPosition(position);
-        shape.setRotation(holder->getRotation());
+        const Player& holderPlayer = holder == 0 ? player1 : player2;
+        position = holderPlayer.getPosition() + holderPlayer.getAimDirection() * 30.0f;
+        rotation = holderPlayer.getRotation();
     }
 }
 
-/// <summary>
-/// Draws the weapon's shape onto the specified render window.
-/// </summary>
-/// <param name="window">The SFML render window where the weapon will be drawn.</param>
-void Weapon::draw(sf::RenderWindow& window) {
-    window.draw(shape);
-}
-
 /// <summary>
 /// Throws the weapon from one player to another, updating its state and velocity accordingly.
 /// </summary>
-/// <param name="from">Pointer to the player currently holding the weapon.</param>
-/// <param name="to">Pointer to the player who is the target of the throw.</param>
-void Weapon::throwTo(Player* from, Player* to) {
-    if (from && to && holder == from) {
+/// <param name="from">The player currently holding the weapon.</param>
+/// <param name="fromIndex">The index of that player, 0 or 1.</param>
+/// <param name="to">The player who is the target of the throw.</param>
+void Weapon::throwTo(Player& from, int fromIndex, const Player& to) {
+    if (holder == fromIndex) {
         isFlying = true;
-        holder->setHasWeapon(false);
-        holder = nullptr;
+        from.setHasWeapon(false);
+        holder = NO_HOLDER;
 
         // Merke wer geworfen hat und setze Cooldown
-        lastHolder = from;
+        lastHolder = static_cast<std::int8_t>(fromIndex);
         throwCooldown = 0.3f; // 0.3 Sekunden Cooldown
 
-        sf::Vector2f direction = to->getPosition() - position;
-        direction = normalize(direction);
+        sf::Vector2f direction = to.getPosition() - position;
+        direction = fastNormalize(direction);
         velocity = direction * WEAPON_THROW_SPEED;
     }
 }
 
 /// <summary>
 /// Checks if the weapon can be picked up by the specified player and updates ownership if possible.
-/// Now also allows catching the weapon while it's flying!
+/// Now also allows catching the weapon while it's flying! The test is swept over the last step, so a fast weapon or a long step cannot pass through the player.
 /// </summary>
 /// <param name="player">A reference to the player attempting to pick up the weapon.</param>
+/// <param name="playerIndex">The index of that player, 0 or 1.</param>
 /// <returns>True if the weapon was successfully picked up by the player; otherwise, false.</returns>
-bool Weapon::checkPickup(Player& player) {
+bool Weapon::checkPickup(Player& player, int playerIndex) {
     // Verhindere dass der werfende Spieler die Waffe sofort wieder aufhebt
-    if (lastHolder == &player && throwCooldown > 0) {
+    if (lastHolder == playerIndex && throwCooldown > 0) {
         return false;
     }
 
-    // Prfe ob Spieler nah genug an der Waffe ist
-    if (!holder && distance(position, player.getPosition()) < 40) {
+    // Prüfe ob Spieler der Waffe im letzten Schritt nah genug kam. Relativ zum
+    // Spieler betrachtet bewegt sich die Waffe auf einer Strecke.
+    sf::Vector2f start = previousPosition - player.getPreviousPosition();
+    sf::Vector2f end = position - player.getPosition();
+    if (holder == NO_HOLDER && sweepCircle(start, end, sf::Vector2f(0, 0), 40) >= 0) {
         // Spieler kann die Waffe aufheben, egal ob sie fliegt oder nicht
-        holder = &player;
+        holder = static_cast<std::int8_t>(playerIndex);
         player.setHasWeapon(true);
 
         // Wenn die Waffe flog, stoppe den Flug
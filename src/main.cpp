@@ -1,7 +1,105 @@
 #include "../include/Game.h"
+#include "../include/Headless.h"
+#include "../include/Benchmark.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
 
-int main() {
-    Game game;
+int main(int argc, char* argv[]) {
+    HeadlessOptions headless;
+    bool runHeadlessMode = false;
+    const char* benchmark = nullptr;
+    float tickRate = Constants::SIM_TICK_RATE;
+    float replaySpeed = 1.0f;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            runHeadlessMode = true;
+        }
+        else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc) {
+            benchmark = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--horde") == 0 && i + 1 < argc) {
+            headless.horde = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--invulnerable") == 0) {
+            headless.invulnerable = true;
+        }
+        else if (std::strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            headless.ticks = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            headless.seed = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            headless.threads = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--latency") == 0 && i + 1 < argc) {
+            headless.latencyFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            headless.recordFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            headless.replayFile = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--seek") == 0 && i + 1 < argc) {
+            headless.seekTick = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (std::strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            replaySpeed = std::strtof(argv[++i], nullptr);
+            if (!(replaySpeed >= Constants::MIN_REPLAY_SPEED && replaySpeed <= Constants::MAX_REPLAY_SPEED)) {
+                std::cout << "--speed muss zwischen " << Constants::MIN_REPLAY_SPEED << " und " << Constants::MAX_REPLAY_SPEED << " liegen" << std::endl;
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--host") == 0 && i + 1 < argc) {
+            headless.hostPort = static_cast<unsigned short>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--join") == 0 && i + 1 < argc) {
+            // HOST oder HOST:PORT
+            char* address = argv[++i];
+            if (char* port = std::strrchr(address, ':')) {
+                *port = '\0';
+                headless.joinPort = static_cast<unsigned short>(std::strtoul(port + 1, nullptr, 10));
+            }
+            headless.joinAddress = address;
+        }
+        else if (std::strcmp(argv[i], "--rollback") == 0 && i + 1 < argc) {
+            headless.rollbackWindow = static_cast<unsigned int>(std::strtoul(argv[++i], nullptr, 10));
+        }
+        else if (std::strcmp(argv[i], "--tickrate") == 0 && i + 1 < argc) {
+            tickRate = std::strtof(argv[++i], nullptr);
+            if (!(tickRate >= 1.0f && tickRate <= Constants::MAX_SIM_TICK_RATE)) {
+                std::cout << "--tickrate muss zwischen 1 und " << Constants::MAX_SIM_TICK_RATE << " liegen" << std::endl;
+                return 1;
+            }
+        }
+    }
+
+    headless.tickRate = tickRate;
+    if (benchmark) {
+        return runBenchmark(benchmark, headless);
+    }
+    if (runHeadlessMode) {
+        if (headless.hostPort != 0 || headless.joinAddress) {
+            return runNetplay(headless);
+        }
+        return headless.replayFile ? runReplay(headless) : runHeadless(headless);
+    }
+
+    GameOptions options;
+    options.tickRate = tickRate;
+    options.latencyFile = headless.latencyFile;
+    options.recordFile = headless.recordFile;
+    options.replayFile = headless.replayFile;
+    options.replaySpeed = replaySpeed;
+    options.seekTick = headless.seekTick;
+    options.hostPort = headless.hostPort;
+    options.joinAddress = headless.joinAddress;
+    options.joinPort = headless.joinPort;
+    options.rollbackWindow = headless.rollbackWindow;
+    Game game(options);
     game.run();
     return 0;
 }
\ No newline at end of file